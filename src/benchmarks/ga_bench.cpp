@@ -0,0 +1,318 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Times the phases of the evolution separately on standard problems across population sizes,
+// genome lengths and gene types, and prints the results as JSON:
+//
+//     ga_bench [--quick] [--generations N]
+//
+// Every result holds the problem parameters and, for each phase, the total time, the number
+// of calls and the number of genotypes processed per second.
+
+#include "api.hpp"
+#include "../examples/uniform_distribution_problem.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+struct phase_timing
+{
+    const char *name;
+    std::int64_t nanoseconds;
+    std::size_t calls;
+    std::size_t genotypes; // genotypes processed by all calls
+};
+
+
+class phase_timer
+{
+public:
+    explicit phase_timer(phase_timing &timing): timing(timing), start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~phase_timer()
+    {
+        const auto finish = std::chrono::steady_clock::now();
+        timing.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count();
+        ++timing.calls;
+    }
+
+private:
+    phase_timing &timing;
+    std::chrono::steady_clock::time_point start;
+};
+
+
+struct benchmark_case
+{
+    std::string problem;
+    std::string gene_type;
+    std::size_t population_size;
+    std::size_t genome_length;
+    std::size_t generations;
+};
+
+
+template <class T> const char *gene_type_name();
+template <> const char *gene_type_name<short>() { return "short"; }
+template <> const char *gene_type_name<int>() { return "int"; }
+template <> const char *gene_type_name<double>() { return "double"; }
+
+
+// Integral genes of Rastrigin problem are fixed-point numbers with this scale.
+template <class T> double rastrigin_scale() { return 0.01; }
+template <> double rastrigin_scale<double>() { return 1.0; }
+
+template <class T> T rastrigin_bound() { return 512; }
+template <> double rastrigin_bound<double>() { return 5.12; }
+
+
+template <class Model>
+void add_operators(const std::shared_ptr<Model> &model)
+{
+    ga::api::model::set_one_point_crossover(model);
+    ga::api::model::add_random_value_mutation_with_uniform_distribution(model, 0.05);
+    ga::api::model::add_random_value_shift_mutation(model, 0.05);
+}
+
+
+// Runs the evolution phase by phase on the population and then applies the operators of the
+// model to standalone genotypes.
+template <class Model>
+std::vector<phase_timing> run_case(const std::shared_ptr<Model> &model,
+                                   typename ga::population<Model>::fitness_function fitness,
+                                   const benchmark_case &c)
+{
+    std::vector<phase_timing> timings = {{"construct_random", 0, 0, 0},
+                                         {"calculate_fitness", 0, 0, 0},
+                                         {"make_selection", 0, 0, 0},
+                                         {"reproduce", 0, 0, 0},
+                                         {"crossover", 0, 0, 0},
+                                         {"mutation", 0, 0, 0}};
+    auto &construction = timings[0];
+    auto &evaluation = timings[1];
+    auto &selection = timings[2];
+    auto &reproduction = timings[3];
+    auto &crossover = timings[4];
+    auto &mutation = timings[5];
+
+    const std::size_t ranking_groups_number = 5;
+    const auto rank_function = [](std::size_t) { return 0.5; };
+
+    model->seed(1);
+    ga::population<Model> population(model, c.population_size);
+    population.seed(1);
+
+    {
+        phase_timer timer(construction);
+        population.init();
+    }
+    construction.genotypes += c.population_size;
+
+    for (std::size_t i = 0; i < c.generations; ++i)
+    {
+        evaluation.genotypes += population.size();
+        {
+            phase_timer timer(evaluation);
+            population.calculate_fitness(fitness);
+        }
+
+        selection.genotypes += population.size();
+        {
+            phase_timer timer(selection);
+            population.make_selection(ranking_groups_number, rank_function);
+        }
+
+        reproduction.genotypes += c.population_size - population.size();
+        {
+            phase_timer timer(reproduction);
+            population.reproduce();
+        }
+    }
+
+    const std::size_t applications = c.population_size * c.generations / 2;
+    ga::genotype_constructor<Model> constructor(model);
+    constructor.seed(1);
+    auto first = constructor.construct_random(0);
+    auto second = constructor.construct_random(1);
+    auto first_child = first;
+    auto second_child = second;
+
+    {
+        phase_timer timer(crossover);
+        for (std::size_t i = 0; i < applications; ++i)
+        {
+            model->crossover(typename Model::const_view(first), typename Model::const_view(second),
+                             typename Model::view(first_child), typename Model::view(second_child));
+        }
+    }
+    crossover.genotypes += 2 * applications;
+
+    {
+        phase_timer timer(mutation);
+        for (std::size_t i = 0; i < applications; ++i)
+        {
+            model->mutate(typename Model::view(first_child));
+        }
+    }
+    mutation.genotypes += applications;
+
+    return timings;
+}
+
+
+template <class T>
+std::vector<phase_timing> run_one_max(const benchmark_case &c)
+{
+    auto model = ga::api::model::create_homogeneous_model<T>(0, 1, c.genome_length);
+    add_operators(model);
+
+    return run_case(model, [](const std::vector<T> &genotype) {
+        return std::accumulate(genotype.cbegin(), genotype.cend(), 0.0) / genotype.size();
+    }, c);
+}
+
+
+template <class T>
+std::vector<phase_timing> run_rastrigin(const benchmark_case &c)
+{
+    auto model = ga::api::model::create_homogeneous_model<T>(-rastrigin_bound<T>(), rastrigin_bound<T>(),
+                                                             c.genome_length);
+    add_operators(model);
+
+    return run_case(model, [](const std::vector<T> &genotype) {
+        const double pi = 3.14159265358979323846;
+        double sum = 0;
+        for (const auto gene : genotype)
+        {
+            const double x = gene * rastrigin_scale<T>();
+            sum += 10 + x * x - 10 * std::cos(2 * pi * x);
+        }
+        return 1.0 / (1.0 + sum / genotype.size());
+    }, c);
+}
+
+
+std::vector<phase_timing> run_uniform_distribution(const benchmark_case &c)
+{
+    std::vector<int> elements(c.genome_length);
+    for (std::size_t i = 0; i < elements.size(); ++i)
+    {
+        elements[i] = 500 + static_cast<int>(i * 337 % 2000);
+    }
+
+    uniform_distribution_problem problem(elements, 3);
+    return run_case(problem.construct_genotype_model(), problem.get_solution_quality_function(), c);
+}
+
+
+std::vector<phase_timing> run(const benchmark_case &c)
+{
+    if (c.problem == "uniform_distribution")
+    {
+        return run_uniform_distribution(c);
+    }
+
+    const bool is_one_max = c.problem == "one_max";
+    if (c.gene_type == "short")
+    {
+        return is_one_max ? run_one_max<short>(c) : run_rastrigin<short>(c);
+    }
+    if (c.gene_type == "int")
+    {
+        return is_one_max ? run_one_max<int>(c) : run_rastrigin<int>(c);
+    }
+    return is_one_max ? run_one_max<double>(c) : run_rastrigin<double>(c);
+}
+
+
+void print_result(std::ostream &out, const benchmark_case &c, const std::vector<phase_timing> &timings)
+{
+    out << "    {\"problem\": \"" << c.problem << "\", \"gene_type\": \"" << c.gene_type
+        << "\", \"population_size\": " << c.population_size << ", \"genome_length\": " << c.genome_length
+        << ", \"generations\": " << c.generations << ", \"phases\": {";
+
+    for (std::size_t i = 0; i < timings.size(); ++i)
+    {
+        const auto &t = timings[i];
+        const double seconds = t.nanoseconds * 1e-9;
+        out << (i > 0 ? ", " : "") << "\"" << t.name << "\": {\"total_ns\": " << t.nanoseconds
+            << ", \"calls\": " << t.calls
+            << ", \"genotypes_per_second\": " << (seconds > 0 ? t.genotypes / seconds : 0.0) << "}";
+    }
+
+    out << "}}";
+}
+
+} // namespace
+
+
+int main(int argc, const char * const * argv)
+{
+    bool is_quick = false;
+    std::size_t generations = 20;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--quick")
+        {
+            is_quick = true;
+        }
+        else if (arg == "--generations" && i + 1 < argc)
+        {
+            generations = std::stoul(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "usage: ga_bench [--quick] [--generations N]" << std::endl;
+            return 1;
+        }
+    }
+
+    const std::vector<std::size_t> population_sizes = is_quick ? std::vector<std::size_t>{100} :
+                                                      std::vector<std::size_t>{100, 1000};
+    const std::vector<std::size_t> genome_lengths = is_quick ? std::vector<std::size_t>{64} :
+                                                    std::vector<std::size_t>{64, 1024};
+
+    std::vector<benchmark_case> cases;
+    for (const auto population_size : population_sizes)
+    {
+        for (const auto genome_length : genome_lengths)
+        {
+            for (const std::string problem : {"one_max", "rastrigin"})
+            {
+                for (const std::string gene_type : {"short", "int", "double"})
+                {
+                    cases.push_back({problem, gene_type, population_size, genome_length, generations});
+                }
+            }
+
+            // The genes of the problem are bin indices of type short.
+            cases.push_back({"uniform_distribution", "short", population_size, genome_length, generations});
+        }
+    }
+
+    std::cout << "{\"benchmark\": \"ga_bench\", \"results\": [\n";
+    for (std::size_t i = 0; i < cases.size(); ++i)
+    {
+        print_result(std::cout, cases[i], run(cases[i]));
+        std::cout << (i + 1 < cases.size() ? ",\n" : "\n");
+    }
+    std::cout << "]}" << std::endl;
+
+    return 0;
+}
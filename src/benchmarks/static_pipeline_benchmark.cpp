@@ -0,0 +1,85 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the dynamic `algorithm` with `static_algorithm` composed of the same operators
+// on the OneMax problem. Both run a fixed number of generations.
+
+#include "api.hpp"
+#include "static_algorithm.hpp"
+
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+using genotype_model_type = ga::genotype_model<int>;
+using genotype_representation = genotype_model_type::representation;
+using distribution_type = std::uniform_int_distribution<int>;
+
+const std::size_t genotype_size = 1000;
+
+
+double one_max(const genotype_representation &genotype)
+{
+    return static_cast<double>(std::accumulate(genotype.cbegin(), genotype.cend(), 0)) / genotype_size;
+}
+
+
+ga::parameters benchmark_parameters(const std::size_t generations)
+{
+    ga::parameters params;
+    params.population_size = 500;
+    params.generations_limit = generations;
+    params.desired_fitness_cap = 2.0;
+    params.time_limit = std::chrono::minutes(10);
+    params.selection = ga::selection_method::truncation;
+    params.random_seed = 1;
+    return params;
+}
+
+
+void report(const std::string &name, const std::size_t generations, const ga::statistics &stats)
+{
+    const auto milliseconds = stats.get_milliseconds_passed();
+    std::cout << name << ": " << milliseconds << " ms, "
+              << static_cast<double>(milliseconds) / generations << " ms per generation, best fitness "
+              << stats.get_best_achieved_fitness() << std::endl;
+}
+
+} // namespace
+
+
+int main(int argc, const char * const * argv)
+{
+    const std::size_t generations = argc > 1 ? std::stoul(argv[1]) : 300;
+    const auto params = benchmark_parameters(generations);
+
+    auto model = ga::api::model::create_homogeneous_model<int>(0, 1, genotype_size);
+    ga::api::model::set_one_point_crossover(model);
+    ga::api::model::add_random_value_mutation_with_uniform_distribution(model, 0.5);
+    ga::api::model::add_random_value_shift_mutation(model, 0.5);
+
+    ga::algorithm<genotype_model_type, ga::double_buffered_storage<genotype_model_type>> dynamic_algorithm(
+            model, one_max, [](std::size_t) { return 0.5; });
+    dynamic_algorithm.run(params);
+    report("dynamic", generations, dynamic_algorithm.get_statistics());
+
+    auto static_algorithm = ga::make_static_algorithm(
+            model,
+            [](const genotype_representation &genotype) { return one_max(genotype); },
+            ga::operators::one_point_crossover<genotype_model_type>(),
+            ga::operators::truncation_selection(params.survivors_fraction),
+            ga::operators::random_value_mutation<genotype_model_type, distribution_type>(0.5),
+            ga::operators::random_value_shift_mutation<genotype_model_type>(0.5));
+    static_algorithm.run(params);
+    report("static", generations, static_algorithm.get_statistics());
+
+    return 0;
+}
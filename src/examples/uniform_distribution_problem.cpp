@@ -7,71 +7,13 @@
 // This example presents the solution to the problem of even
 // placement of objects between given number of bins.
 
-#include "api.hpp"
+#include "uniform_distribution_problem.hpp"
 #include "logging/console_logger.hpp"
 
 #include <vector>
 #include <iostream>
 #include <memory>
-#include <random>
-#include <algorithm>
-#include <numeric>
-
-
-class uniform_distribution_problem
-{
-public:
-    using genotype_model_type = ga::genotype_model<short>;
-    using genotype_representation = genotype_model_type::representation;
-    using gene_params_type = genotype_model_type::gene_params;
-
-public:
-    uniform_distribution_problem(const std::vector<int> &elements, const int bins_count):
-            elements(elements), bins_count(bins_count)
-    {
-    }
-
-    auto construct_genotype_model()
-    {
-        auto model = ga::api::model::create_homogeneous_model<short>(0, static_cast<short>(bins_count - 1), elements.size());
-        ga::api::model::set_one_point_crossover(model);
-        ga::api::model::add_random_value_mutation_with_uniform_distribution(model, 0.05);
-        ga::api::model::add_random_value_shift_mutation(model, 0.05);
-
-        return model;
-    }
-
-    auto get_solution_quality_function()
-    {
-        const int sum = std::accumulate(elements.cbegin(), elements.cend(), 0);
-        const double expected_bin_load = sum / bins_count;
-
-        return [this, expected_bin_load](const genotype_representation &genotype) -> double
-        {
-            std::vector<int> bins(static_cast<std::size_t>(bins_count), 0);
-            std::vector<double> load_balance(bins.size(), 0);
-
-            for (std::size_t i = 0; i < genotype.size(); ++i)
-            {
-                bins[static_cast<std::size_t>(genotype[i])] += elements[i];
-            }
-
-            for (std::size_t i = 0; i < bins.size(); ++i)
-            {
-                const double diff = std::abs(expected_bin_load - static_cast<double>(bins[i]));
-                load_balance[i] = 1.0 - (diff / expected_bin_load);
-            }
-
-            const double average_result =
-                    std::accumulate(load_balance.cbegin(), load_balance.cend(), 0.0) / load_balance.size();
-            return average_result;
-        };
-    }
-
-private:
-    std::vector<int> elements;
-    int bins_count;
-};
+#include <string>
 
 
 int main(int argc, const char * const * argv)
@@ -97,6 +39,13 @@ int main(int argc, const char * const * argv)
     auto ga_algorithm = ga::api::create_algorithm(
             genotype_model, problem.get_solution_quality_function(), [](std::size_t i) {return 0.5;}
     );
+    ga_algorithm.set_batch_fitness_function(problem.get_batch_solution_quality_function());
+
+    if (argc > 1 && std::string(argv[1]) == "--incremental")
+    {
+        ga_algorithm.set_incremental_fitness(
+                std::make_shared<uniform_distribution_problem::incremental_solution_quality>(problem));
+    }
 
     ga::parameters params;
     params.time_limit = std::chrono::seconds(60);
@@ -0,0 +1,160 @@
+
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Problem of even placement of objects between given number of bins.
+
+#pragma once
+
+#include "api.hpp"
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+
+class uniform_distribution_problem
+{
+public:
+    using genotype_model_type = ga::genotype_model<short>;
+    using genotype_representation = genotype_model_type::representation;
+    using gene_params_type = genotype_model_type::gene_params;
+    using algorithm_type = ga::algorithm<genotype_model_type>;
+
+public:
+    uniform_distribution_problem(const std::vector<int> &elements, const int bins_count):
+            elements(elements), bins_count(bins_count)
+    {
+    }
+
+    auto construct_genotype_model()
+    {
+        auto model = ga::api::model::create_homogeneous_model<short>(0, static_cast<short>(bins_count - 1), elements.size());
+        ga::api::model::set_one_point_crossover(model);
+        ga::api::model::add_random_value_mutation_with_uniform_distribution(model, 0.05);
+        ga::api::model::add_random_value_shift_mutation(model, 0.05);
+
+        return model;
+    }
+
+    auto get_solution_quality_function()
+    {
+        const int sum = std::accumulate(elements.cbegin(), elements.cend(), 0);
+        const double expected_bin_load = sum / bins_count;
+
+        return [this, expected_bin_load](const genotype_representation &genotype) -> double
+        {
+            std::vector<int> bins(static_cast<std::size_t>(bins_count), 0);
+            std::vector<double> load_balance(bins.size(), 0);
+
+            for (std::size_t i = 0; i < genotype.size(); ++i)
+            {
+                bins[static_cast<std::size_t>(genotype[i])] += elements[i];
+            }
+
+            for (std::size_t i = 0; i < bins.size(); ++i)
+            {
+                const double diff = std::abs(expected_bin_load - static_cast<double>(bins[i]));
+                load_balance[i] = 1.0 - (diff / expected_bin_load);
+            }
+
+            const double average_result =
+                    std::accumulate(load_balance.cbegin(), load_balance.cend(), 0.0) / load_balance.size();
+            return average_result;
+        };
+    }
+
+    // Evaluates a batch of genotypes reusing the same bins buffer for all of them.
+    auto get_batch_solution_quality_function()
+    {
+        const int sum = std::accumulate(elements.cbegin(), elements.cend(), 0);
+        const double expected_bin_load = sum / bins_count;
+
+        return [this, expected_bin_load](const ga::genotype_batch<algorithm_type::population_type::storage_type> &batch,
+                                         ga::functions::fitness_scores scores)
+        {
+            std::vector<int> bins(static_cast<std::size_t>(bins_count));
+
+            for (std::size_t k = 0; k < batch.size(); ++k)
+            {
+                const auto &genotype = batch[k];
+                std::fill(bins.begin(), bins.end(), 0);
+
+                for (std::size_t i = 0; i < genotype.size(); ++i)
+                {
+                    bins[static_cast<std::size_t>(genotype[i])] += elements[i];
+                }
+
+                double load_balance_sum = 0;
+                for (const auto bin : bins)
+                {
+                    const double diff = std::abs(expected_bin_load - static_cast<double>(bin));
+                    load_balance_sum += 1.0 - (diff / expected_bin_load);
+                }
+
+                scores[k] = load_balance_sum / bins.size();
+            }
+        };
+    }
+
+    // Keeps loads of bins as the state of every genotype, so moving of a few elements
+    // between bins is evaluated without going through the whole genotype.
+    class incremental_solution_quality : public algorithm_type::incremental_fitness_type
+    {
+    public:
+        incremental_solution_quality(const uniform_distribution_problem &problem):
+                problem(problem),
+                expected_bin_load(std::accumulate(problem.elements.cbegin(), problem.elements.cend(), 0) /
+                                  problem.bins_count)
+        {
+        }
+
+        double evaluate(const genotype_representation &genotype, state_type &bins) const override
+        {
+            bins.assign(static_cast<std::size_t>(problem.bins_count), 0.0);
+            for (std::size_t i = 0; i < genotype.size(); ++i)
+            {
+                bins[static_cast<std::size_t>(genotype[i])] += problem.elements[i];
+            }
+
+            return load_balance(bins);
+        }
+
+        double update(const genotype_representation &genotype, const genotype_representation &parent, double,
+                      state_type &bins, const ga::operators::change_set &changes) const override
+        {
+            for (const auto i : changes.get_indices())
+            {
+                bins[static_cast<std::size_t>(parent[i])] -= problem.elements[i];
+                bins[static_cast<std::size_t>(genotype[i])] += problem.elements[i];
+            }
+
+            return load_balance(bins);
+        }
+
+    private:
+        double load_balance(const state_type &bins) const
+        {
+            double load_balance_sum = 0;
+            for (const auto bin : bins)
+            {
+                const double diff = std::abs(expected_bin_load - bin);
+                load_balance_sum += 1.0 - (diff / expected_bin_load);
+            }
+
+            return load_balance_sum / bins.size();
+        }
+
+    private:
+        const uniform_distribution_problem &problem;
+        double expected_bin_load;
+    };
+
+private:
+    std::vector<int> elements;
+    int bins_count;
+};
@@ -10,6 +10,8 @@
 #define _GA_API_HPP_
 
 #include "ga.hpp"
+#include "binary_genotype.hpp"
+#include "permutation_genotype.hpp"
 
 #include <cstddef>
 #include <memory>
@@ -28,6 +30,17 @@ namespace api
     }
 
 
+    // Genes of the whole population are kept in one buffer and
+    // the fitness function receives genotypes as views.
+    template <class T, class FitnessFunc, class RankFunc>
+    auto create_flat_algorithm(const std::shared_ptr<genotype_model<T>> &model,
+                               FitnessFunc fitness_function,
+                               RankFunc rank_function)
+    {
+        return ga::algorithm<genotype_model<T>, flat_storage<genotype_model<T>>>(model, fitness_function, rank_function);
+    }
+
+
     namespace model
     {
         template <class T>
@@ -42,30 +55,178 @@ namespace api
         }
 
 
-        template<class T>
-        void set_one_point_crossover(const genotype_model_ptr_type<T> &model)
+        // Genotypes are arrays of `N` genes, see fixed_genotype_model.hpp.
+        template<class T, std::size_t N>
+        auto create_fixed_model(const T &min_value, const T &max_value)
+        {
+            using model_type = fixed_genotype_model<T, N>;
+            return std::make_shared<model_type>(typename model_type::gene_params(min_value, max_value));
+        }
+
+
+        template<class Model>
+        void set_one_point_crossover(const std::shared_ptr<Model> &model)
         {
             model->set_crossover_operator(
-                    std::make_unique<ga::operators::one_point_crossover<genotype_model<T>>>()
+                    std::make_unique<ga::operators::one_point_crossover<Model>>()
             );
         }
 
 
-        template<class T>
-        void add_random_value_mutation_with_uniform_distribution(const genotype_model_ptr_type<T> &model, const double probability)
+        template<class Model>
+        void set_two_point_crossover(const std::shared_ptr<Model> &model)
+        {
+            model->set_crossover_operator(
+                    std::make_unique<ga::operators::two_point_crossover<Model>>()
+            );
+        }
+
+
+        template<class Model>
+        void set_uniform_crossover(const std::shared_ptr<Model> &model)
+        {
+            model->set_crossover_operator(
+                    std::make_unique<ga::operators::uniform_crossover<Model>>()
+            );
+        }
+
+
+        template<class Model>
+        void set_blend_crossover(const std::shared_ptr<Model> &model)
+        {
+            model->set_crossover_operator(
+                    std::make_unique<ga::operators::blend_crossover<Model>>()
+            );
+        }
+
+
+        template<class Model>
+        void add_random_value_mutation_with_uniform_distribution(const std::shared_ptr<Model> &model, const double probability)
         {
-            using distribution_type = typename select_uniform_distribution_type<T>::type;
+            using distribution_type = typename select_uniform_distribution_type<typename Model::value_type>::type;
             model->add_mutation_operator(
-                    std::make_unique<ga::operators::random_value_mutation<genotype_model<T>, distribution_type>>(probability)
+                    std::make_unique<ga::operators::random_value_mutation<Model, distribution_type>>(probability)
             );
         }
 
 
-        template<class T>
-        void add_random_value_shift_mutation(const genotype_model_ptr_type<T> &model, const double probability)
+        template<class Model>
+        void add_random_value_shift_mutation(const std::shared_ptr<Model> &model, const double probability)
+        {
+            model->add_mutation_operator(
+                    std::make_unique<ga::operators::random_value_shift_mutation<Model>>(probability)
+            );
+        }
+
+
+        // Mutates every gene with the given probability.
+        template<class Model>
+        void add_per_gene_random_value_mutation_with_uniform_distribution(const std::shared_ptr<Model> &model,
+                                                                          const double probability)
+        {
+            using distribution_type = typename select_uniform_distribution_type<typename Model::value_type>::type;
+            model->add_mutation_operator(
+                    std::make_unique<ga::operators::per_gene_random_value_mutation<Model, distribution_type>>(probability)
+            );
+        }
+
+
+        // Mutates every gene with the given probability.
+        template<class Model>
+        void add_per_gene_random_value_shift_mutation(const std::shared_ptr<Model> &model, const double probability)
+        {
+            model->add_mutation_operator(
+                    std::make_unique<ga::operators::per_gene_random_value_shift_mutation<Model>>(probability)
+            );
+        }
+
+
+        // Genes are bits packed into words, see binary_genotype.hpp.
+        inline auto create_binary_model(const std::size_t bits_count)
+        {
+            return std::make_shared<binary_genotype_model>(binary::gene_params(bits_count));
+        }
+
+
+        inline void set_binary_uniform_crossover(const std::shared_ptr<binary_genotype_model> &model)
+        {
+            model->set_crossover_operator(
+                    std::make_unique<ga::operators::binary_uniform_crossover<binary_genotype_model>>()
+            );
+        }
+
+
+        inline void set_binary_one_point_crossover(const std::shared_ptr<binary_genotype_model> &model)
+        {
+            model->set_crossover_operator(
+                    std::make_unique<ga::operators::binary_one_point_crossover<binary_genotype_model>>()
+            );
+        }
+
+
+        // Flips every bit with the given probability.
+        inline void add_bit_flip_mutation(const std::shared_ptr<binary_genotype_model> &model, const double probability)
+        {
+            model->add_mutation_operator(
+                    std::make_unique<ga::operators::bit_flip_mutation<binary_genotype_model>>(probability)
+            );
+        }
+
+
+        // Genotypes are permutations of 0, 1, ..., size - 1, see permutation_genotype.hpp.
+        inline auto create_permutation_model(const std::size_t size)
+        {
+            return std::make_shared<permutation_genotype_model>(size);
+        }
+
+
+        inline void set_order_crossover(const std::shared_ptr<permutation_genotype_model> &model)
+        {
+            model->set_crossover_operator(
+                    std::make_unique<ga::operators::order_crossover<permutation_base_model>>()
+            );
+        }
+
+
+        inline void set_partially_mapped_crossover(const std::shared_ptr<permutation_genotype_model> &model)
+        {
+            model->set_crossover_operator(
+                    std::make_unique<ga::operators::partially_mapped_crossover<permutation_base_model>>()
+            );
+        }
+
+
+        inline void set_cycle_crossover(const std::shared_ptr<permutation_genotype_model> &model)
+        {
+            model->set_crossover_operator(
+                    std::make_unique<ga::operators::cycle_crossover<permutation_base_model>>()
+            );
+        }
+
+
+        // Swaps two genes with the given probability.
+        inline void add_swap_mutation(const std::shared_ptr<permutation_genotype_model> &model, const double probability)
+        {
+            model->add_mutation_operator(
+                    std::make_unique<ga::operators::swap_mutation<permutation_base_model>>(probability)
+            );
+        }
+
+
+        // Moves a gene to another position with the given probability.
+        inline void add_insert_mutation(const std::shared_ptr<permutation_genotype_model> &model, const double probability)
+        {
+            model->add_mutation_operator(
+                    std::make_unique<ga::operators::insert_mutation<permutation_base_model>>(probability)
+            );
+        }
+
+
+        // Reverses a segment of genes with the given probability.
+        inline void add_inversion_mutation(const std::shared_ptr<permutation_genotype_model> &model, const double probability)
         {
             model->add_mutation_operator(
-                    std::make_unique<ga::operators::random_value_shift_mutation<genotype_model<T>>>(probability)
+                    std::make_unique<ga::operators::inversion_mutation<permutation_base_model>>(probability)
             );
         }
     }
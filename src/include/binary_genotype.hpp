@@ -0,0 +1,365 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Binary genotypes packed 64 genes per word. The model is genotype_model<std::uint64_t>
+// whose genes are words, so all storages and populations work with it as they are, while
+// the operators below work on bits with word-level masks.
+
+#pragma once
+
+#include "genotype_model.hpp"
+#include "operators/crossover.hpp"
+#include "operators/mutation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+namespace ga
+{
+
+using binary_genotype_model = genotype_model<std::uint64_t>;
+
+
+namespace binary
+{
+
+using word_type = std::uint64_t;
+
+const std::size_t word_bits = 64;
+
+
+inline std::size_t words_count(const std::size_t bits_count)
+{
+    return (bits_count + word_bits - 1) / word_bits;
+}
+
+
+inline unsigned popcount(const word_type x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_popcountll(x));
+#else
+    word_type v = x - ((x >> 1) & 0x5555555555555555ull);
+    v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<unsigned>((v * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+
+// Parameters of the words of a genotype of `bits_count` bits. The maximum value of every word
+// is the mask of its bits in use, so the padding bits of the last word stay zero.
+inline std::vector<binary_genotype_model::gene_params> gene_params(const std::size_t bits_count)
+{
+    std::vector<binary_genotype_model::gene_params> result;
+    result.reserve(words_count(bits_count));
+    for (std::size_t begin = 0; begin < bits_count; begin += word_bits)
+    {
+        const std::size_t used = std::min(word_bits, bits_count - begin);
+        const word_type mask = used == word_bits ? ~word_type(0) : (word_type(1) << used) - 1;
+        result.emplace_back(word_type(0), mask);
+    }
+
+    return result;
+}
+
+
+inline std::size_t bits_count(const binary_genotype_model &model)
+{
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < model.size(); ++i)
+    {
+        result += popcount(model.get_gene_params(i).max_value);
+    }
+
+    return result;
+}
+
+
+template <class Genes>
+bool test(const Genes &genes, const std::size_t bit)
+{
+    return (genes[bit / word_bits] >> (bit % word_bits)) & 1u;
+}
+
+
+template <class Genes>
+void set(Genes &&genes, const std::size_t bit, const bool value)
+{
+    const word_type mask = word_type(1) << (bit % word_bits);
+    auto &word = genes[bit / word_bits];
+    word = value ? (word | mask) : (word & ~mask);
+}
+
+
+// Number of set bits.
+template <class Genes>
+std::size_t count(const Genes &genes)
+{
+    std::size_t result = 0;
+    for (const auto word : genes)
+    {
+        result += popcount(word);
+    }
+
+    return result;
+}
+
+
+inline word_type random_word(random_generator &rg)
+{
+    auto &engine = rg.get_engine();
+    const word_type high = engine();
+    return (high << 32) | engine();
+}
+
+
+// Word in which every bit is set with probability `probability` rounded to 1/256. The mask is
+// built from the binary digits of the probability: or-ing a random word doubles the distance
+// of the probability from 1, and-ing halves it.
+inline word_type random_mask(random_generator &rg, const double probability)
+{
+    const auto digits = static_cast<unsigned>(std::lround(std::min(std::max(probability, 0.0), 1.0) * 256));
+    if (digits >= 256)
+    {
+        return ~word_type(0);
+    }
+
+    word_type mask = 0;
+    bool started = false;
+    for (unsigned i = 0; i < 8; ++i)
+    {
+        if ((digits >> i) & 1u)
+        {
+            mask = random_word(rg) | mask;
+            started = true;
+        }
+        else if (started)
+        {
+            mask = random_word(rg) & mask;
+        }
+    }
+
+    return mask;
+}
+
+} // namespace binary
+
+
+namespace operators
+{
+
+// Takes every bit from either parent with equal probability, a word at a time.
+template <class GenotypeModel>
+class binary_uniform_crossover : public crossover<GenotypeModel>
+{
+public:
+    using genotype = typename GenotypeModel::representation;
+    using view = typename crossover<GenotypeModel>::view;
+    using const_view = typename crossover<GenotypeModel>::const_view;
+
+public:
+    std::pair<genotype, genotype> apply(const genotype &a, const genotype &b) override final
+    {
+        std::pair<genotype, genotype> children(genotype(a.size()), genotype(a.size()));
+        cross(a, b, children.first, children.second);
+        return children;
+    }
+
+    void apply(const_view a, const_view b, view first, view second) override final
+    {
+        cross(a, b, first, second);
+    }
+
+private:
+    template <class Parent, class Child>
+    void cross(const Parent &a, const Parent &b, Child &first, Child &second)
+    {
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            const auto mask = binary::random_word(this->rg);
+            first[i] = (a[i] & mask) | (b[i] & ~mask);
+            second[i] = (b[i] & mask) | (a[i] & ~mask);
+        }
+    }
+};
+
+
+// Exchanges the tails of the parents after a bit chosen at random. Only the word holding
+// the point is masked, the others are copied whole.
+template <class GenotypeModel>
+class binary_one_point_crossover : public crossover<GenotypeModel>
+{
+public:
+    using genotype = typename GenotypeModel::representation;
+    using view = typename crossover<GenotypeModel>::view;
+    using const_view = typename crossover<GenotypeModel>::const_view;
+
+public:
+    std::pair<genotype, genotype> apply(const genotype &a, const genotype &b) override final
+    {
+        std::pair<genotype, genotype> children(genotype(a.size()), genotype(a.size()));
+        cross(a, b, children.first, children.second);
+        return children;
+    }
+
+    void apply(const_view a, const_view b, view first, view second) override final
+    {
+        cross(a, b, first, second);
+    }
+
+private:
+    template <class Parent, class Child>
+    void cross(const Parent &a, const Parent &b, Child &first, Child &second)
+    {
+        const std::size_t bits = a.size() * binary::word_bits;
+        const std::size_t point = this->rg.generate(std::uniform_int_distribution<std::size_t>(1, bits - 1));
+        const std::size_t point_word = point / binary::word_bits;
+        const auto head = (binary::word_type(1) << (point % binary::word_bits)) - 1;
+
+        for (std::size_t i = 0; i < point_word; ++i)
+        {
+            first[i] = a[i];
+            second[i] = b[i];
+        }
+
+        first[point_word] = (a[point_word] & head) | (b[point_word] & ~head);
+        second[point_word] = (b[point_word] & head) | (a[point_word] & ~head);
+
+        for (std::size_t i = point_word + 1; i < a.size(); ++i)
+        {
+            first[i] = b[i];
+            second[i] = a[i];
+        }
+    }
+};
+
+
+// Flips every bit with the probability of the mutation multiplied by the multiplier of its word.
+// Frequent flips are applied with random masks, rare ones are found by geometric skips over the
+// bits, so a sparse mutation of a long genome costs about as much as the bits it flips.
+template <class GenotypeModel>
+class bit_flip_mutation : public mutation<GenotypeModel>
+{
+public:
+    using genotype = typename GenotypeModel::representation;
+    using view = typename mutation<GenotypeModel>::view;
+
+public:
+    bit_flip_mutation(const double probability, const double dense_rate = 1.0 / 32):
+            mutation<GenotypeModel>(probability),
+            dense_rate(dense_rate),
+            rates_model(nullptr),
+            rates_probability(0),
+            max_rate(0)
+    {
+    }
+
+    void apply(const GenotypeModel &model, genotype &g) override final
+    {
+        mutate(model, g, nullptr);
+    }
+
+    void apply(const GenotypeModel &model, view g) override final
+    {
+        mutate(model, g, nullptr);
+    }
+
+    // Changed words are added to `changes`.
+    void apply(const GenotypeModel &model, view g, change_set &changes) override final
+    {
+        mutate(model, g, &changes);
+    }
+
+private:
+    template <class Genes>
+    void mutate(const GenotypeModel &model, Genes &g, change_set *changes)
+    {
+        update_rates(model, g.size());
+        if (max_rate <= 0)
+        {
+            return;
+        }
+
+        if (max_rate >= dense_rate)
+        {
+            for (std::size_t i = 0; i < g.size(); ++i)
+            {
+                const auto flips = binary::random_mask(this->rg, rates[i]) & model.get_gene_params(i).max_value;
+                flip(g, i, flips, changes);
+            }
+            return;
+        }
+
+        // Candidates are drawn at the maximum rate and thinned to the rate of their word.
+        const std::size_t bits = g.size() * binary::word_bits;
+        std::bernoulli_distribution keep;
+        for (std::size_t bit = this->rg.generate(gaps); bit < bits; bit += 1 + this->rg.generate(gaps))
+        {
+            const std::size_t word = bit / binary::word_bits;
+            if (rates[word] < max_rate && !this->rg.generate(std::bernoulli_distribution(rates[word] / max_rate)))
+            {
+                continue;
+            }
+
+            const auto flips = (binary::word_type(1) << (bit % binary::word_bits)) & model.get_gene_params(word).max_value;
+            flip(g, word, flips, changes);
+        }
+    }
+
+    template <class Genes>
+    static void flip(Genes &g, const std::size_t word, const binary::word_type flips, change_set *changes)
+    {
+        if (flips == 0)
+        {
+            return;
+        }
+
+        g[word] ^= flips;
+        instrumentation::count_mutation(binary::popcount(flips));
+        if (changes != nullptr) changes->add(word);
+    }
+
+    void update_rates(const GenotypeModel &model, const std::size_t size)
+    {
+        const double probability = this->get_probability();
+        if (rates_model == &model && rates.size() == size && rates_probability == probability)
+        {
+            return;
+        }
+
+        rates_model = &model;
+        rates_probability = probability;
+        rates.resize(size);
+        max_rate = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            rates[i] = std::min(std::max(probability * model.get_gene_params(i).mutation_probability_multiplier, 0.0), 1.0);
+            max_rate = std::max(max_rate, rates[i]);
+        }
+
+        if (max_rate > 0 && max_rate < dense_rate)
+        {
+            gaps = std::geometric_distribution<std::size_t>(max_rate);
+        }
+    }
+
+private:
+    double dense_rate;
+    const GenotypeModel *rates_model;
+    double rates_probability;
+    std::vector<double> rates;
+    double max_rate;
+    std::geometric_distribution<std::size_t> gaps;
+};
+
+} // namespace operators
+} // namespace ga
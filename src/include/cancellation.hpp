@@ -0,0 +1,70 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+
+
+namespace ga
+{
+
+// Stops a run from another thread. The run polls the token inside fitness calculation and
+// reproduction as well as between generations, so it stops soon after cancel() is called
+// or the deadline passes. Copies share the same state.
+class cancellation_token
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+public:
+    cancellation_token(): state(std::make_shared<shared_state>())
+    {
+    }
+
+    void cancel()
+    {
+        state->is_cancelled.store(true, std::memory_order_release);
+    }
+
+    // The token counts as cancelled once `deadline` passes.
+    void set_deadline(const clock::time_point deadline)
+    {
+        state->deadline.store(deadline.time_since_epoch().count(), std::memory_order_release);
+    }
+
+    bool is_cancelled() const
+    {
+        if (state->is_cancelled.load(std::memory_order_acquire))
+        {
+            return true;
+        }
+
+        const auto deadline = state->deadline.load(std::memory_order_acquire);
+        return deadline != no_deadline() && clock::now().time_since_epoch().count() >= deadline;
+    }
+
+private:
+    using rep = clock::duration::rep;
+
+    static rep no_deadline()
+    {
+        return std::numeric_limits<rep>::max();
+    }
+
+    struct shared_state
+    {
+        std::atomic<bool> is_cancelled{false};
+        std::atomic<rep> deadline{no_deadline()};
+    };
+
+private:
+    std::shared_ptr<shared_state> state;
+};
+
+} // namespace ga
@@ -0,0 +1,295 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "detail/serialization.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace ga
+{
+
+// Counters of the run stored in a checkpoint along with the population.
+struct checkpoint_counters
+{
+    std::uint64_t generations;
+    double best_achieved_fitness;
+    std::int64_t milliseconds_passed;
+};
+
+
+namespace detail
+{
+
+const std::uint32_t checkpoint_magic = 0x4B434147; // "GACK"
+const std::uint32_t checkpoint_version = 1;
+
+
+// Read-only view of a whole file. The file is mapped into memory where possible,
+// so even large checkpoints are opened without reading them.
+class mapped_file
+{
+public:
+    explicit mapped_file(const std::string &path): data(nullptr), size(0)
+    {
+#if !defined(_WIN32)
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0)
+        {
+            void *ptr = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (ptr != MAP_FAILED)
+            {
+                data = static_cast<const unsigned char *>(ptr);
+                size = static_cast<std::size_t>(info.st_size);
+            }
+        }
+        close(fd);
+#else
+        std::ifstream file(path, std::ios::binary);
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data = reinterpret_cast<const unsigned char *>(buffer.data());
+        size = buffer.size();
+#endif
+    }
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    ~mapped_file()
+    {
+#if !defined(_WIN32)
+        if (data != nullptr)
+        {
+            munmap(const_cast<unsigned char *>(data), size);
+        }
+#endif
+    }
+
+    bool is_open() const
+    {
+        return data != nullptr;
+    }
+
+    const unsigned char *get_data() const
+    {
+        return data;
+    }
+
+    std::size_t get_size() const
+    {
+        return size;
+    }
+
+private:
+    const unsigned char *data;
+    std::size_t size;
+#if defined(_WIN32)
+    std::vector<char> buffer;
+#endif
+};
+
+
+// Writes to a temporary file next to `path` and renames it, so the file at `path`
+// is always either the previous or the new complete checkpoint.
+inline bool write_file_atomically(const std::string &path, const std::vector<unsigned char> &data)
+{
+    const std::string temporary_path = path + ".tmp";
+
+#if !defined(_WIN32)
+    const int fd = open(temporary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    std::size_t written = 0;
+    while (written < data.size())
+    {
+        const ssize_t result = write(fd, data.data() + written, data.size() - written);
+        if (result <= 0)
+        {
+            close(fd);
+            return false;
+        }
+        written += static_cast<std::size_t>(result);
+    }
+
+    const bool is_synced = fsync(fd) == 0;
+    close(fd);
+    return is_synced && std::rename(temporary_path.c_str(), path.c_str()) == 0;
+#else
+    {
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file)
+        {
+            return false;
+        }
+    }
+
+    std::remove(path.c_str());
+    return std::rename(temporary_path.c_str(), path.c_str()) == 0;
+#endif
+}
+
+} // namespace detail
+
+
+// Encodes a checkpoint of the population into `buffer`, which is cleared first.
+template <class Population>
+void write_checkpoint(std::vector<unsigned char> &buffer, Population &p, const checkpoint_counters &counters)
+{
+    buffer.clear();
+    detail::binary_writer writer(buffer);
+    writer.write(detail::checkpoint_magic);
+    writer.write(detail::checkpoint_version);
+    writer.write(counters);
+    p.save_state(writer);
+}
+
+
+// Restores the population and counters. Returns false if the data is not a checkpoint
+// of a population with the same model and size.
+template <class Population>
+bool read_checkpoint(const unsigned char *data, const std::size_t size, Population &p, checkpoint_counters &counters)
+{
+    detail::binary_reader reader(data, size);
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    return reader.read(magic) && magic == detail::checkpoint_magic &&
+           reader.read(version) && version == detail::checkpoint_version &&
+           reader.read(counters) && p.load_state(reader);
+}
+
+
+// Writes checkpoints to a file on a background thread. Encoding is left to the caller, and a
+// checkpoint submitted while the previous one is still being written is skipped, so the
+// evolution never waits for the disk.
+class checkpoint_writer
+{
+public:
+    explicit checkpoint_writer(std::string path):
+            path(std::move(path)),
+            has_pending(false),
+            is_stopping(false),
+            written_count(0),
+            failed_count(0),
+            worker([this] { work(); })
+    {
+    }
+
+    checkpoint_writer(const checkpoint_writer &) = delete;
+    checkpoint_writer &operator=(const checkpoint_writer &) = delete;
+
+    ~checkpoint_writer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            is_stopping = true;
+        }
+        wake_up.notify_all();
+        worker.join();
+    }
+
+    // Takes the content of `data` and gives back a previously written buffer, so buffers
+    // are reused. Returns false and leaves `data` untouched if the writer is busy.
+    bool try_submit(std::vector<unsigned char> &data)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (has_pending)
+            {
+                return false;
+            }
+
+            std::swap(pending, data);
+            has_pending = true;
+        }
+
+        wake_up.notify_all();
+        return true;
+    }
+
+    // Waits until the submitted checkpoint is written.
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return !has_pending; });
+    }
+
+    std::size_t get_written_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return written_count;
+    }
+
+    std::size_t get_failed_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return failed_count;
+    }
+
+private:
+    void work()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            wake_up.wait(lock, [this] { return has_pending || is_stopping; });
+            if (!has_pending)
+            {
+                return;
+            }
+
+            // The buffer is not touched by try_submit() while has_pending is set.
+            lock.unlock();
+            const bool is_written = detail::write_file_atomically(path, pending);
+            lock.lock();
+
+            ++(is_written ? written_count : failed_count);
+            has_pending = false;
+            done.notify_all();
+        }
+    }
+
+private:
+    std::string path;
+    std::vector<unsigned char> pending;
+    bool has_pending;
+    bool is_stopping;
+    std::size_t written_count;
+    std::size_t failed_count;
+    mutable std::mutex mutex;
+    std::condition_variable wake_up;
+    std::condition_variable done;
+    std::thread worker;
+};
+
+} // namespace ga
@@ -0,0 +1,354 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Crossover kernels over contiguous gene buffers. Genes of 2, 4 and 8 bytes are processed
+// with AVX2 or SSE2 vectors, whichever the compiler targets, the rest of the genes and all
+// other types are processed one by one with the same result. Gene i is chosen by bit i % 32
+// of the word i / 32 of a random bit mask.
+
+#pragma once
+
+#include "../random_generator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+
+namespace ga
+{
+namespace detail
+{
+
+// Fills `bits` with `count` random bits.
+inline void random_bits(random_generator &rg, std::vector<std::uint32_t> &bits, const std::size_t count)
+{
+    bits.resize((count + 31) / 32);
+    rg.get_engine().generate(bits.data(), bits.size());
+}
+
+
+inline bool test_bit(const std::uint32_t *bits, const std::size_t index)
+{
+    return (bits[index / 32] >> (index % 32)) & 1u;
+}
+
+
+namespace simd
+{
+
+template <std::size_t Size>
+using size_tag = std::integral_constant<std::size_t, Size>;
+
+#if defined(__AVX2__)
+
+const std::size_t vector_bytes = 32;
+
+inline __m256i load(const void *ptr) { return _mm256_loadu_si256(static_cast<const __m256i *>(ptr)); }
+inline void store(void *ptr, const __m256i v) { _mm256_storeu_si256(static_cast<__m256i *>(ptr), v); }
+
+// Lanes of `if_set` where `mask` is set, lanes of `if_clear` elsewhere.
+inline __m256i select(const __m256i mask, const __m256i if_set, const __m256i if_clear)
+{
+    return _mm256_blendv_epi8(if_clear, if_set, mask);
+}
+
+// Sets every lane of genes of the given size whose bit in the low bits of `bits` is set.
+inline __m256i lanes_mask(const std::uint32_t bits, size_tag<2>)
+{
+    const __m256i lanes = _mm256_setr_epi16(0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80, 0x100, 0x200, 0x400, 0x800,
+                                            0x1000, 0x2000, 0x4000, static_cast<short>(0x8000));
+    return _mm256_cmpeq_epi16(_mm256_and_si256(_mm256_set1_epi16(static_cast<short>(bits)), lanes), lanes);
+}
+
+inline __m256i lanes_mask(const std::uint32_t bits, size_tag<4>)
+{
+    const __m256i lanes = _mm256_setr_epi32(0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80);
+    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int>(bits)), lanes), lanes);
+}
+
+inline __m256i lanes_mask(const std::uint32_t bits, size_tag<8>)
+{
+    const __m256i lanes = _mm256_setr_epi32(0x1, 0x1, 0x2, 0x2, 0x4, 0x4, 0x8, 0x8);
+    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int>(bits)), lanes), lanes);
+}
+
+// Genes where `mask` is set become a + weight * (b - a).
+inline std::size_t blend(const double *a, const double *b, double *first, double *second, const std::size_t size,
+                         const std::uint32_t *bits, const double weight)
+{
+    const __m256d w = _mm256_set1_pd(weight);
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        const __m256d mask = _mm256_castsi256_pd(lanes_mask(bits[i / 32] >> (i % 32), size_tag<8>()));
+        const __m256d va = _mm256_loadu_pd(a + i);
+        const __m256d vb = _mm256_loadu_pd(b + i);
+        const __m256d to_first = _mm256_add_pd(va, _mm256_mul_pd(w, _mm256_sub_pd(vb, va)));
+        const __m256d to_second = _mm256_add_pd(vb, _mm256_mul_pd(w, _mm256_sub_pd(va, vb)));
+        _mm256_storeu_pd(first + i, _mm256_blendv_pd(va, to_first, mask));
+        _mm256_storeu_pd(second + i, _mm256_blendv_pd(vb, to_second, mask));
+    }
+
+    return i;
+}
+
+// Four integral genes widened to 32 bits and back.
+inline __m128i load_widened(const int *ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)); }
+inline __m128i load_widened(const short *ptr)
+{
+    return _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(ptr)));
+}
+
+inline void store_narrowed(int *ptr, const __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(ptr), v); }
+inline void store_narrowed(short *ptr, const __m128i v)
+{
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(ptr), _mm_packs_epi32(v, v));
+}
+
+// weight * difference rounded half away from zero.
+inline __m128i rounded_shift(const __m256d weight, const __m256d difference)
+{
+    const __m256d shift = _mm256_mul_pd(weight, difference);
+    const __m256d half = _mm256_or_pd(_mm256_set1_pd(0.5), _mm256_and_pd(shift, _mm256_set1_pd(-0.0)));
+    return _mm256_cvttpd_epi32(_mm256_add_pd(shift, half));
+}
+
+template <class T>
+std::size_t blend_integral(const T *a, const T *b, T *first, T *second, const std::size_t size,
+                           const std::uint32_t *bits, const double weight)
+{
+    const __m256d w = _mm256_set1_pd(weight);
+    const __m128i lanes = _mm_setr_epi32(0x1, 0x2, 0x4, 0x8);
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        const __m128i selected = _mm_set1_epi32(static_cast<int>(bits[i / 32] >> (i % 32)));
+        const __m128i mask = _mm_cmpeq_epi32(_mm_and_si128(selected, lanes), lanes);
+        const __m128i va = load_widened(a + i);
+        const __m128i vb = load_widened(b + i);
+        const __m256d difference = _mm256_sub_pd(_mm256_cvtepi32_pd(vb), _mm256_cvtepi32_pd(va));
+        const __m128i to_first = _mm_add_epi32(va, rounded_shift(w, difference));
+        const __m128i to_second = _mm_add_epi32(vb, rounded_shift(w, _mm256_sub_pd(_mm256_setzero_pd(), difference)));
+        store_narrowed(first + i, _mm_blendv_epi8(va, to_first, mask));
+        store_narrowed(second + i, _mm_blendv_epi8(vb, to_second, mask));
+    }
+
+    return i;
+}
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+const std::size_t vector_bytes = 16;
+
+inline __m128i load(const void *ptr) { return _mm_loadu_si128(static_cast<const __m128i *>(ptr)); }
+inline void store(void *ptr, const __m128i v) { _mm_storeu_si128(static_cast<__m128i *>(ptr), v); }
+
+inline __m128i select(const __m128i mask, const __m128i if_set, const __m128i if_clear)
+{
+    return _mm_or_si128(_mm_and_si128(mask, if_set), _mm_andnot_si128(mask, if_clear));
+}
+
+inline __m128i lanes_mask(const std::uint32_t bits, size_tag<2>)
+{
+    const __m128i lanes = _mm_setr_epi16(0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80);
+    return _mm_cmpeq_epi16(_mm_and_si128(_mm_set1_epi16(static_cast<short>(bits)), lanes), lanes);
+}
+
+inline __m128i lanes_mask(const std::uint32_t bits, size_tag<4>)
+{
+    const __m128i lanes = _mm_setr_epi32(0x1, 0x2, 0x4, 0x8);
+    return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(static_cast<int>(bits)), lanes), lanes);
+}
+
+inline __m128i lanes_mask(const std::uint32_t bits, size_tag<8>)
+{
+    const __m128i lanes = _mm_setr_epi32(0x1, 0x1, 0x2, 0x2);
+    return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(static_cast<int>(bits)), lanes), lanes);
+}
+
+inline std::size_t blend(const double *a, const double *b, double *first, double *second, const std::size_t size,
+                         const std::uint32_t *bits, const double weight)
+{
+    const __m128d w = _mm_set1_pd(weight);
+    std::size_t i = 0;
+    for (; i + 2 <= size; i += 2)
+    {
+        const __m128d mask = _mm_castsi128_pd(lanes_mask(bits[i / 32] >> (i % 32), size_tag<8>()));
+        const __m128d va = _mm_loadu_pd(a + i);
+        const __m128d vb = _mm_loadu_pd(b + i);
+        const __m128d to_first = _mm_add_pd(va, _mm_mul_pd(w, _mm_sub_pd(vb, va)));
+        const __m128d to_second = _mm_add_pd(vb, _mm_mul_pd(w, _mm_sub_pd(va, vb)));
+        _mm_storeu_pd(first + i, _mm_or_pd(_mm_and_pd(mask, to_first), _mm_andnot_pd(mask, va)));
+        _mm_storeu_pd(second + i, _mm_or_pd(_mm_and_pd(mask, to_second), _mm_andnot_pd(mask, vb)));
+    }
+
+    return i;
+}
+
+// Two integral genes widened to 32 bits and back.
+inline __m128i load_widened(const int *ptr) { return _mm_loadl_epi64(reinterpret_cast<const __m128i *>(ptr)); }
+inline __m128i load_widened(const short *ptr)
+{
+    std::int32_t pair;
+    std::memcpy(&pair, ptr, sizeof(pair));
+    const __m128i v = _mm_cvtsi32_si128(pair);
+    return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+}
+
+inline void store_narrowed(int *ptr, const __m128i v) { _mm_storel_epi64(reinterpret_cast<__m128i *>(ptr), v); }
+inline void store_narrowed(short *ptr, const __m128i v)
+{
+    const std::int32_t pair = _mm_cvtsi128_si32(_mm_packs_epi32(v, v));
+    std::memcpy(ptr, &pair, sizeof(pair));
+}
+
+inline __m128i rounded_shift(const __m128d weight, const __m128d difference)
+{
+    const __m128d shift = _mm_mul_pd(weight, difference);
+    const __m128d half = _mm_or_pd(_mm_set1_pd(0.5), _mm_and_pd(shift, _mm_set1_pd(-0.0)));
+    return _mm_cvttpd_epi32(_mm_add_pd(shift, half));
+}
+
+template <class T>
+std::size_t blend_integral(const T *a, const T *b, T *first, T *second, const std::size_t size,
+                           const std::uint32_t *bits, const double weight)
+{
+    const __m128d w = _mm_set1_pd(weight);
+    std::size_t i = 0;
+    for (; i + 2 <= size; i += 2)
+    {
+        const __m128i mask = lanes_mask(bits[i / 32] >> (i % 32), size_tag<4>());
+        const __m128i va = load_widened(a + i);
+        const __m128i vb = load_widened(b + i);
+        const __m128d difference = _mm_sub_pd(_mm_cvtepi32_pd(vb), _mm_cvtepi32_pd(va));
+        const __m128i to_first = _mm_add_epi32(va, rounded_shift(w, difference));
+        const __m128i to_second = _mm_add_epi32(vb, rounded_shift(w, _mm_sub_pd(_mm_setzero_pd(), difference)));
+        store_narrowed(first + i, select(mask, to_first, va));
+        store_narrowed(second + i, select(mask, to_second, vb));
+    }
+
+    return i;
+}
+
+#else
+
+const std::size_t vector_bytes = 0;
+
+#endif
+
+
+template <class T>
+struct has_lanes : std::integral_constant<bool, vector_bytes != 0 && std::is_arithmetic<T>::value &&
+                                                (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)>
+{
+};
+
+
+// Returns the number of genes processed, always a multiple of the number of lanes.
+template <class T>
+std::size_t uniform_crossover(const T *, const T *, T *, T *, std::size_t, const std::uint32_t *, std::false_type)
+{
+    return 0;
+}
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+template <class T>
+std::size_t uniform_crossover(const T *a, const T *b, T *first, T *second, const std::size_t size,
+                              const std::uint32_t *bits, std::true_type)
+{
+    const std::size_t lanes = vector_bytes / sizeof(T);
+    std::size_t i = 0;
+    for (; i + lanes <= size; i += lanes)
+    {
+        const auto mask = lanes_mask(bits[i / 32] >> (i % 32), size_tag<sizeof(T)>());
+        const auto va = load(a + i);
+        const auto vb = load(b + i);
+        store(first + i, select(mask, va, vb));
+        store(second + i, select(mask, vb, va));
+    }
+
+    return i;
+}
+
+
+inline std::size_t blend(const int *a, const int *b, int *first, int *second, const std::size_t size,
+                         const std::uint32_t *bits, const double weight)
+{
+    return blend_integral(a, b, first, second, size, bits, weight);
+}
+
+inline std::size_t blend(const short *a, const short *b, short *first, short *second, const std::size_t size,
+                         const std::uint32_t *bits, const double weight)
+{
+    return blend_integral(a, b, first, second, size, bits, weight);
+}
+#endif
+
+
+inline std::size_t blend(const void *, const void *, void *, void *, std::size_t, const std::uint32_t *, double)
+{
+    return 0;
+}
+
+} // namespace simd
+
+
+// Where bit i is set, the first child takes gene i of `a` and the second one of `b`, elsewhere
+// the other way round.
+template <class T>
+void uniform_crossover(const T *a, const T *b, T *first, T *second, const std::size_t size,
+                       const std::uint32_t *bits)
+{
+    std::size_t i = simd::uniform_crossover(a, b, first, second, size, bits, simd::has_lanes<T>());
+    for (; i < size; ++i)
+    {
+        const bool from_a = test_bit(bits, i);
+        first[i] = from_a ? a[i] : b[i];
+        second[i] = from_a ? b[i] : a[i];
+    }
+}
+
+
+template <class T>
+T blend_gene(const T a, const T b, const double weight, std::true_type)
+{
+    const double shift = weight * (static_cast<double>(b) - a);
+    return static_cast<T>(a + static_cast<long long>(shift < 0 ? shift - 0.5 : shift + 0.5));
+}
+
+template <class T>
+T blend_gene(const T a, const T b, const double weight, std::false_type)
+{
+    return a + weight * (b - a);
+}
+
+
+// Where bit i is set, the first child gets a + weight * (b - a) and the second one
+// b + weight * (a - b), rounded half away from zero for integral genes. Other genes are
+// copied from the parents.
+template <class T>
+void blend_crossover(const T *a, const T *b, T *first, T *second, const std::size_t size,
+                     const std::uint32_t *bits, const double weight)
+{
+    std::size_t i = simd::blend(a, b, first, second, size, bits, weight);
+    for (; i < size; ++i)
+    {
+        const bool is_blended = test_bit(bits, i);
+        first[i] = is_blended ? blend_gene(a[i], b[i], weight, std::is_integral<T>()) : a[i];
+        second[i] = is_blended ? blend_gene(b[i], a[i], weight, std::is_integral<T>()) : b[i];
+    }
+}
+
+} // namespace detail
+} // namespace ga
@@ -7,7 +7,11 @@
 #pragma once
 
 #include <cstddef>
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <iterator>
+#include <utility>
 
 
 namespace ga
@@ -15,14 +19,15 @@ namespace ga
 namespace detail
 {
 
+// Writes selected elements into `result`, reusing its storage.
 template <class Cont>
-Cont split_by_groups_and_select(
+void split_by_groups_and_select(
         const Cont &container,
         const std::size_t groups_count,
-        std::function<double(std::size_t)> f)
+        const std::function<double(std::size_t)> &f,
+        Cont &result)
 {
-    Cont result;
-    result.reserve(container.size());
+    result.clear();
     const std::size_t elements_count_per_group = container.size() / groups_count;
 
     auto it = container.begin();
@@ -41,6 +46,18 @@ Cont split_by_groups_and_select(
 
         std::advance(it, elements_count_per_group - how_much_to_select_from_group);
     }
+}
+
+
+template <class Cont>
+Cont split_by_groups_and_select(
+        const Cont &container,
+        const std::size_t groups_count,
+        std::function<double(std::size_t)> f)
+{
+    Cont result;
+    result.reserve(container.size());
+    split_by_groups_and_select(container, groups_count, f, result);
 
     return result;
 }
@@ -49,24 +66,84 @@ Cont split_by_groups_and_select(
 template <class Genotype>
 auto one_point_crossover(const Genotype &a, const Genotype &b, const std::size_t point_index)
 {
-    std::pair<Genotype, Genotype> result;
+    std::pair<Genotype, Genotype> result(a, b);
 
-    const std::size_t size = a.size();
-    result.first.reserve(size);
-    result.second.reserve(size);
+    for (std::size_t i = point_index; i < a.size(); ++i)
+    {
+        std::swap(result.first[i], result.second[i]);
+    }
 
-    auto it_a = a.cbegin();
-    auto it_b = b.cbegin();
-    std::advance(it_a, point_index);
-    std::advance(it_b, point_index);
+    return result;
+}
 
-    std::copy(a.cbegin(), it_a, std::back_inserter(result.first));
-    std::copy(it_b, b.cend(), std::back_inserter(result.first));
 
-    std::copy(b.cbegin(), it_b, std::back_inserter(result.second));
-    std::copy(it_a, a.cend(), std::back_inserter(result.second));
+// Makes or fills a genotype of the given representation from a range of genes. Containers
+// are constructed from the range or assigned it, std::array is filled with it.
+template <class Genotype>
+struct genotype_from_range
+{
+    template <class Iterator>
+    static Genotype make(Iterator first, Iterator last)
+    {
+        return Genotype(first, last);
+    }
 
-    return result;
+    template <class Iterator>
+    static void assign(Genotype &genotype, Iterator first, Iterator last)
+    {
+        genotype.assign(first, last);
+    }
+};
+
+template <class T, std::size_t N>
+struct genotype_from_range<std::array<T, N>>
+{
+    template <class Iterator>
+    static std::array<T, N> make(Iterator first, Iterator last)
+    {
+        std::array<T, N> result{};
+        std::copy(first, last, result.begin());
+        return result;
+    }
+
+    template <class Iterator>
+    static void assign(std::array<T, N> &genotype, Iterator first, Iterator last)
+    {
+        std::copy(first, last, genotype.begin());
+    }
+};
+
+template <class Genotype, class Iterator>
+Genotype make_genotype(Iterator first, Iterator last)
+{
+    return genotype_from_range<Genotype>::make(first, last);
+}
+
+template <class Genotype, class Iterator>
+void assign_genotype(Genotype &genotype, Iterator first, Iterator last)
+{
+    genotype_from_range<Genotype>::assign(genotype, first, last);
+}
+
+
+// Writes children into preallocated ranges of the parents length.
+template <class GenotypeA, class GenotypeB, class ChildA, class ChildB>
+void one_point_crossover(const GenotypeA &a, const GenotypeB &b, const std::size_t point_index,
+                         ChildA &&first, ChildB &&second)
+{
+    const std::size_t size = a.size();
+
+    for (std::size_t i = 0; i < point_index; ++i)
+    {
+        first[i] = a[i];
+        second[i] = b[i];
+    }
+
+    for (std::size_t i = point_index; i < size; ++i)
+    {
+        first[i] = b[i];
+        second[i] = a[i];
+    }
 }
 
 
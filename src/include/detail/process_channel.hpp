@@ -0,0 +1,196 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+
+namespace ga
+{
+
+enum class process_transport
+{
+    shared_memory,
+    local_socket
+};
+
+
+namespace detail
+{
+
+// One-directional message channel between a parent process and its forked children, usable by
+// one sending and one receiving process. Messages go through a lock-free ring buffer in a shared
+// anonymous mapping; when the mapping cannot be created, or sockets are requested, they go
+// through a non-blocking Unix domain datagram socket pair. Sending never blocks: a message which
+// does not fit is rejected.
+class process_channel
+{
+public:
+    process_channel(const std::size_t capacity, const process_transport preferred):
+            transport(preferred),
+            region(nullptr),
+            region_size(0),
+            ring_capacity(capacity)
+    {
+        sockets[0] = -1;
+        sockets[1] = -1;
+
+        if (transport == process_transport::shared_memory)
+        {
+            region_size = sizeof(ring_header) + ring_capacity;
+            void *ptr = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+            if (ptr != MAP_FAILED)
+            {
+                region = static_cast<unsigned char *>(ptr);
+                new (region) ring_header();
+                return;
+            }
+
+            transport = process_transport::local_socket;
+        }
+
+        if (socketpair(AF_UNIX, SOCK_DGRAM, 0, sockets) == 0)
+        {
+            const int buffer_size = static_cast<int>(capacity);
+            setsockopt(sockets[0], SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+            setsockopt(sockets[1], SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+            fcntl(sockets[0], F_SETFL, fcntl(sockets[0], F_GETFL) | O_NONBLOCK);
+            fcntl(sockets[1], F_SETFL, fcntl(sockets[1], F_GETFL) | O_NONBLOCK);
+        }
+    }
+
+    process_channel(const process_channel &) = delete;
+    process_channel &operator=(const process_channel &) = delete;
+
+    ~process_channel()
+    {
+        if (region != nullptr)
+        {
+            munmap(region, region_size);
+        }
+
+        for (const int fd : sockets)
+        {
+            if (fd >= 0) close(fd);
+        }
+    }
+
+    bool try_send(const std::vector<unsigned char> &message)
+    {
+        if (region == nullptr)
+        {
+            return sockets[0] >= 0 && send(sockets[0], message.data(), message.size(), MSG_DONTWAIT) ==
+                                      static_cast<ssize_t>(message.size());
+        }
+
+        auto &header = *reinterpret_cast<ring_header *>(region);
+        const std::uint64_t tail = header.tail.load(std::memory_order_relaxed);
+        const std::uint64_t head = header.head.load(std::memory_order_acquire);
+        const std::uint32_t size = static_cast<std::uint32_t>(message.size());
+        if (sizeof(size) + message.size() > ring_capacity - (tail - head))
+        {
+            return false;
+        }
+
+        copy_in(tail, &size, sizeof(size));
+        copy_in(tail + sizeof(size), message.data(), message.size());
+        header.tail.store(tail + sizeof(size) + message.size(), std::memory_order_release);
+        return true;
+    }
+
+    // `message` is resized to the received message.
+    bool try_receive(std::vector<unsigned char> &message)
+    {
+        if (region == nullptr)
+        {
+            if (sockets[1] < 0)
+            {
+                return false;
+            }
+
+            message.resize(ring_capacity);
+            const ssize_t received = recv(sockets[1], message.data(), message.size(), MSG_DONTWAIT);
+            if (received < 0)
+            {
+                return false;
+            }
+
+            message.resize(static_cast<std::size_t>(received));
+            return true;
+        }
+
+        auto &header = *reinterpret_cast<ring_header *>(region);
+        const std::uint64_t head = header.head.load(std::memory_order_relaxed);
+        if (head == header.tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        std::uint32_t size = 0;
+        copy_out(head, &size, sizeof(size));
+        message.resize(size);
+        copy_out(head + sizeof(size), message.data(), size);
+        header.head.store(head + sizeof(size) + size, std::memory_order_release);
+        return true;
+    }
+
+    process_transport get_transport() const
+    {
+        return transport;
+    }
+
+private:
+    // Positions grow monotonically and are wrapped only when bytes are copied.
+    struct ring_header
+    {
+        std::atomic<std::uint64_t> head{0};
+        char head_padding[64 - sizeof(std::uint64_t)];
+        std::atomic<std::uint64_t> tail{0};
+        char tail_padding[64 - sizeof(std::uint64_t)];
+    };
+
+    unsigned char *ring_data() const
+    {
+        return region + sizeof(ring_header);
+    }
+
+    void copy_in(const std::uint64_t position, const void *source, const std::size_t count)
+    {
+        const std::size_t offset = static_cast<std::size_t>(position % ring_capacity);
+        const std::size_t first_part = std::min(count, ring_capacity - offset);
+        std::memcpy(ring_data() + offset, source, first_part);
+        std::memcpy(ring_data(), static_cast<const unsigned char *>(source) + first_part, count - first_part);
+    }
+
+    void copy_out(const std::uint64_t position, void *destination, const std::size_t count) const
+    {
+        const std::size_t offset = static_cast<std::size_t>(position % ring_capacity);
+        const std::size_t first_part = std::min(count, ring_capacity - offset);
+        std::memcpy(destination, ring_data() + offset, first_part);
+        std::memcpy(static_cast<unsigned char *>(destination) + first_part, ring_data(), count - first_part);
+    }
+
+private:
+    process_transport transport;
+    unsigned char *region;
+    std::size_t region_size;
+    std::size_t ring_capacity;
+    int sockets[2];
+};
+
+} // namespace detail
+} // namespace ga
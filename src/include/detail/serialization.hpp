@@ -0,0 +1,168 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+
+namespace ga
+{
+namespace detail
+{
+
+// Appends values in the native byte order, so encoded data is meant for the same machine.
+class binary_writer
+{
+public:
+    explicit binary_writer(std::vector<unsigned char> &buffer): buffer(buffer)
+    {
+    }
+
+    template <class T>
+    void write(const T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be written");
+        const std::size_t position = buffer.size();
+        buffer.resize(position + sizeof(T));
+        std::memcpy(buffer.data() + position, &value, sizeof(T));
+    }
+
+    void write_bytes(const void *data, const std::size_t size)
+    {
+        const std::size_t position = buffer.size();
+        buffer.resize(position + size);
+        std::memcpy(buffer.data() + position, data, size);
+    }
+
+private:
+    std::vector<unsigned char> &buffer;
+};
+
+
+// Reads values written by binary_writer. After the first read past the end all reads fail.
+class binary_reader
+{
+public:
+    binary_reader(const unsigned char *data, const std::size_t size):
+            data(data),
+            size(size),
+            position(0)
+    {
+    }
+
+    template <class T>
+    bool read(T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be read");
+        return read_bytes(&value, sizeof(T));
+    }
+
+    bool read_bytes(void *destination, const std::size_t count)
+    {
+        if (count > size - position)
+        {
+            position = size;
+            return false;
+        }
+
+        std::memcpy(destination, data + position, count);
+        position += count;
+        return true;
+    }
+
+    std::size_t remaining() const
+    {
+        return size - position;
+    }
+
+private:
+    const unsigned char *data;
+    std::size_t size;
+    std::size_t position;
+};
+
+
+// Writes `length` genes as raw values of `ValueType`.
+template <class ValueType, class Genes>
+void write_genes(binary_writer &writer, const Genes &genes, const std::size_t length)
+{
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        writer.write(static_cast<ValueType>(genes[i]));
+    }
+}
+
+
+// Reads into the first `length` genes. Returns false if the data is truncated.
+template <class ValueType, class Genes>
+bool read_genes(binary_reader &reader, Genes &&genes, const std::size_t length)
+{
+    if (static_cast<std::uint64_t>(length) * sizeof(ValueType) > reader.remaining())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        ValueType value{};
+        if (!reader.read(value))
+        {
+            return false;
+        }
+        genes[i] = value;
+    }
+
+    return true;
+}
+
+
+// Genotypes are encoded as their count and length followed by raw gene values.
+template <class Genotype>
+void write_genotypes(binary_writer &writer, const std::vector<Genotype> &genotypes)
+{
+    using value_type = typename Genotype::value_type;
+
+    const std::uint32_t length = genotypes.empty() ? 0 : static_cast<std::uint32_t>(genotypes.front().size());
+    writer.write(static_cast<std::uint32_t>(genotypes.size()));
+    writer.write(length);
+
+    for (const auto &genotype : genotypes)
+    {
+        write_genes<value_type>(writer, genotype, length);
+    }
+}
+
+
+// Elements of `genotypes` are reused. Returns false if the data is truncated.
+template <class Genotype>
+bool read_genotypes(binary_reader &reader, std::vector<Genotype> &genotypes)
+{
+    using value_type = typename Genotype::value_type;
+
+    std::uint32_t count = 0;
+    std::uint32_t length = 0;
+    if (!reader.read(count) || !reader.read(length) ||
+        static_cast<std::uint64_t>(count) * length * sizeof(value_type) > reader.remaining())
+    {
+        return false;
+    }
+
+    genotypes.resize(count);
+    for (auto &genotype : genotypes)
+    {
+        genotype.resize(length);
+        read_genes<value_type>(reader, genotype, length);
+    }
+
+    return true;
+}
+
+} // namespace detail
+} // namespace ga
@@ -0,0 +1,82 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace ga
+{
+namespace detail
+{
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// Slots are reused, so elements which own memory keep their capacity between uses.
+template <class T>
+class spsc_queue
+{
+public:
+    explicit spsc_queue(const std::size_t capacity):
+            slots(capacity + 1),
+            head(0),
+            tail(0)
+    {
+    }
+
+    spsc_queue(const spsc_queue &) = delete;
+    spsc_queue &operator=(const spsc_queue &) = delete;
+
+    // Returns false and leaves `value` untouched when the queue is full.
+    bool try_push(T &value)
+    {
+        const std::size_t current_tail = tail.load(std::memory_order_relaxed);
+        const std::size_t next_tail = next(current_tail);
+        if (next_tail == head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        std::swap(slots[current_tail], value);
+        tail.store(next_tail, std::memory_order_release);
+        return true;
+    }
+
+    // Swaps the oldest element into `value`, so the previous content of `value` is recycled.
+    bool try_pop(T &value)
+    {
+        const std::size_t current_head = head.load(std::memory_order_relaxed);
+        if (current_head == tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        std::swap(slots[current_head], value);
+        head.store(next(current_head), std::memory_order_release);
+        return true;
+    }
+
+    std::size_t capacity() const
+    {
+        return slots.size() - 1;
+    }
+
+private:
+    std::size_t next(const std::size_t position) const
+    {
+        return position + 1 == slots.size() ? 0 : position + 1;
+    }
+
+private:
+    std::vector<T> slots;
+    alignas(64) std::atomic<std::size_t> head;
+    alignas(64) std::atomic<std::size_t> tail;
+};
+
+} // namespace detail
+} // namespace ga
@@ -0,0 +1,244 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+
+namespace ga
+{
+
+enum class cache_eviction_policy
+{
+    lru,
+    clock
+};
+
+
+template <class Genotype>
+struct genotype_hash
+{
+    std::size_t operator()(const Genotype &genotype) const
+    {
+        using value_type = typename Genotype::value_type;
+        std::hash<value_type> hasher;
+
+        std::size_t seed = genotype.size();
+        for (const auto &gene : genotype)
+        {
+            seed ^= hasher(gene) + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2);
+        }
+
+        return seed;
+    }
+};
+
+
+// Bounded map from genotypes to already calculated fitness values.
+// Entries live in a fixed number of slots, so after the cache is filled up
+// evicted slots reuse the memory of the genotypes they held.
+template <class Genotype>
+class fitness_cache
+{
+public:
+    fitness_cache(const std::size_t capacity, const cache_eviction_policy policy):
+            max_size(capacity),
+            policy(policy),
+            lru_head(npos),
+            lru_tail(npos),
+            clock_hand(0),
+            hits_count(0),
+            misses_count(0)
+    {
+        slots.reserve(max_size);
+        index.reserve(max_size);
+    }
+
+    bool find(const Genotype &genotype, double &fitness)
+    {
+        const auto it = index.find(&genotype);
+        if (it == index.end())
+        {
+            ++misses_count;
+            return false;
+        }
+
+        ++hits_count;
+        touch(it->second);
+        fitness = slots[it->second].fitness;
+        return true;
+    }
+
+    void insert(const Genotype &genotype, const double fitness)
+    {
+        if (max_size == 0)
+        {
+            return;
+        }
+
+        const auto it = index.find(&genotype);
+        if (it != index.end())
+        {
+            slots[it->second].fitness = fitness;
+            touch(it->second);
+            return;
+        }
+
+        std::size_t slot_index;
+        if (slots.size() < max_size)
+        {
+            slot_index = slots.size();
+            slots.emplace_back();
+            slots.back().genotype = genotype;
+            lru_push_front(slot_index);
+        }
+        else
+        {
+            slot_index = select_victim();
+            index.erase(&slots[slot_index].genotype);
+            slots[slot_index].genotype = genotype;
+            touch(slot_index);
+        }
+
+        slots[slot_index].fitness = fitness;
+        slots[slot_index].referenced = false;
+        index.emplace(&slots[slot_index].genotype, slot_index);
+    }
+
+    void clear()
+    {
+        slots.clear();
+        index.clear();
+        lru_head = lru_tail = npos;
+        clock_hand = 0;
+    }
+
+    std::size_t size() const
+    {
+        return slots.size();
+    }
+
+    std::size_t capacity() const
+    {
+        return max_size;
+    }
+
+    cache_eviction_policy get_policy() const
+    {
+        return policy;
+    }
+
+    std::size_t get_hits_count() const
+    {
+        return hits_count;
+    }
+
+    std::size_t get_misses_count() const
+    {
+        return misses_count;
+    }
+
+private:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    struct slot
+    {
+        Genotype genotype;
+        double fitness = 0;
+        bool referenced = false;
+        std::size_t prev = npos;
+        std::size_t next = npos;
+    };
+
+    struct pointer_hash
+    {
+        std::size_t operator()(const Genotype *ptr) const
+        {
+            return genotype_hash<Genotype>()(*ptr);
+        }
+    };
+
+    struct pointer_equal
+    {
+        bool operator()(const Genotype *a, const Genotype *b) const
+        {
+            return *a == *b;
+        }
+    };
+
+    void touch(const std::size_t slot_index)
+    {
+        if (policy == cache_eviction_policy::clock)
+        {
+            slots[slot_index].referenced = true;
+        }
+        else if (lru_head != slot_index)
+        {
+            lru_unlink(slot_index);
+            lru_push_front(slot_index);
+        }
+    }
+
+    std::size_t select_victim()
+    {
+        if (policy == cache_eviction_policy::lru)
+        {
+            return lru_tail;
+        }
+
+        // Second chance: referenced slots are spared once on every revolution of the hand.
+        while (slots[clock_hand].referenced)
+        {
+            slots[clock_hand].referenced = false;
+            clock_hand = (clock_hand + 1) % slots.size();
+        }
+
+        const std::size_t victim = clock_hand;
+        clock_hand = (clock_hand + 1) % slots.size();
+        return victim;
+    }
+
+    void lru_unlink(const std::size_t slot_index)
+    {
+        auto &s = slots[slot_index];
+        if (s.prev != npos) slots[s.prev].next = s.next; else lru_head = s.next;
+        if (s.next != npos) slots[s.next].prev = s.prev; else lru_tail = s.prev;
+        s.prev = s.next = npos;
+    }
+
+    void lru_push_front(const std::size_t slot_index)
+    {
+        if (policy != cache_eviction_policy::lru)
+        {
+            return;
+        }
+
+        auto &s = slots[slot_index];
+        s.prev = npos;
+        s.next = lru_head;
+        if (lru_head != npos) slots[lru_head].prev = slot_index;
+        lru_head = slot_index;
+        if (lru_tail == npos) lru_tail = slot_index;
+    }
+
+private:
+    std::size_t max_size;
+    cache_eviction_policy policy;
+    std::vector<slot> slots;
+    std::unordered_map<const Genotype *, std::size_t, pointer_hash, pointer_equal> index;
+    std::size_t lru_head;
+    std::size_t lru_tail;
+    std::size_t clock_hand;
+    std::size_t hits_count;
+    std::size_t misses_count;
+};
+
+} // namespace ga
@@ -0,0 +1,224 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+
+namespace ga
+{
+
+// Distribution of fitness values of one generation. Quartiles are approximate.
+struct fitness_summary
+{
+    std::size_t count = 0;
+    double mean = 0;
+    double variance = 0;
+    double min = 0;
+    double max = 0;
+    double lower_quartile = 0;
+    double median = 0;
+    double upper_quartile = 0;
+};
+
+
+namespace detail
+{
+
+// Streaming estimate of a quantile by the P-square algorithm of Jain and Chlamtac:
+// five markers are moved along the values with piecewise parabolic interpolation,
+// so memory does not depend on the number of values.
+class p2_quantile
+{
+public:
+    explicit p2_quantile(const double probability = 0.5): probability(probability), count(0)
+    {
+    }
+
+    void reset()
+    {
+        count = 0;
+    }
+
+    void add(const double x)
+    {
+        if (count < 5)
+        {
+            heights[count++] = x;
+            if (count == 5)
+            {
+                std::sort(heights, heights + 5);
+                for (int i = 0; i < 5; ++i)
+                {
+                    positions[i] = i + 1;
+                }
+
+                desired[0] = 1;
+                desired[1] = 1 + 2 * probability;
+                desired[2] = 1 + 4 * probability;
+                desired[3] = 3 + 2 * probability;
+                desired[4] = 5;
+
+                increments[0] = 0;
+                increments[1] = probability / 2;
+                increments[2] = probability;
+                increments[3] = (1 + probability) / 2;
+                increments[4] = 1;
+            }
+            return;
+        }
+
+        ++count;
+
+        int cell;
+        if (x < heights[0])
+        {
+            heights[0] = x;
+            cell = 0;
+        }
+        else if (x >= heights[4])
+        {
+            heights[4] = x;
+            cell = 3;
+        }
+        else
+        {
+            cell = 0;
+            while (x >= heights[cell + 1]) ++cell;
+        }
+
+        for (int i = cell + 1; i < 5; ++i)
+        {
+            positions[i] += 1;
+        }
+
+        for (int i = 0; i < 5; ++i)
+        {
+            desired[i] += increments[i];
+        }
+
+        for (int i = 1; i < 4; ++i)
+        {
+            const double d = desired[i] - positions[i];
+            if ((d >= 1 && positions[i + 1] - positions[i] > 1) || (d <= -1 && positions[i - 1] - positions[i] < -1))
+            {
+                const int step = d > 0 ? 1 : -1;
+                const double candidate = parabolic(i, step);
+                heights[i] = heights[i - 1] < candidate && candidate < heights[i + 1] ? candidate : linear(i, step);
+                positions[i] += step;
+            }
+        }
+    }
+
+    // Exact for fewer than five values.
+    double value() const
+    {
+        if (count >= 5)
+        {
+            return heights[2];
+        }
+
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        double sorted[5];
+        std::copy(heights, heights + count, sorted);
+        std::sort(sorted, sorted + count);
+        const auto index = static_cast<std::size_t>(std::lround(probability * (count - 1)));
+        return sorted[index];
+    }
+
+private:
+    double parabolic(const int i, const int step) const
+    {
+        const double d = step;
+        return heights[i] + d / (positions[i + 1] - positions[i - 1]) *
+                            ((positions[i] - positions[i - 1] + d) * (heights[i + 1] - heights[i]) /
+                             (positions[i + 1] - positions[i]) +
+                             (positions[i + 1] - positions[i] - d) * (heights[i] - heights[i - 1]) /
+                             (positions[i] - positions[i - 1]));
+    }
+
+    double linear(const int i, const int step) const
+    {
+        return heights[i] + step * (heights[i + step] - heights[i]) / (positions[i + step] - positions[i]);
+    }
+
+private:
+    double probability;
+    std::size_t count;
+    double heights[5];
+    double positions[5];
+    double desired[5];
+    double increments[5];
+};
+
+} // namespace detail
+
+
+// Builds fitness_summary from values passed one by one.
+class fitness_summary_accumulator
+{
+public:
+    fitness_summary_accumulator(): lower_quartile(0.25), median(0.5), upper_quartile(0.75)
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        summary = fitness_summary();
+        summary.min = std::numeric_limits<double>::infinity();
+        summary.max = -std::numeric_limits<double>::infinity();
+        squared_deviations = 0;
+        lower_quartile.reset();
+        median.reset();
+        upper_quartile.reset();
+    }
+
+    // Mean and variance are updated by Welford's method.
+    void add(const double x)
+    {
+        ++summary.count;
+        const double delta = x - summary.mean;
+        summary.mean += delta / summary.count;
+        squared_deviations += delta * (x - summary.mean);
+        summary.min = std::min(summary.min, x);
+        summary.max = std::max(summary.max, x);
+        lower_quartile.add(x);
+        median.add(x);
+        upper_quartile.add(x);
+    }
+
+    fitness_summary get() const
+    {
+        if (summary.count == 0)
+        {
+            return fitness_summary();
+        }
+
+        fitness_summary result = summary;
+        result.variance = squared_deviations / summary.count;
+        result.lower_quartile = lower_quartile.value();
+        result.median = median.value();
+        result.upper_quartile = upper_quartile.value();
+        return result;
+    }
+
+private:
+    fitness_summary summary;
+    double squared_deviations;
+    detail::p2_quantile lower_quartile;
+    detail::p2_quantile median;
+    detail::p2_quantile upper_quartile;
+};
+
+} // namespace ga
@@ -0,0 +1,171 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "genotype_model.hpp"
+#include "operators/crossover.hpp"
+#include "operators/mutation.hpp"
+#include "random_generator.hpp"
+#include "genotype_view.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+namespace ga
+{
+
+// Model of genotypes of the length `N` known at compile time. Genotypes are std::array, so
+// storages keep them inline without allocations of their own, and loops over genes of the
+// genotypes have constant bounds. It is used with the same operators as genotype_model.
+template <class T, std::size_t N>
+class fixed_genotype_model
+{
+public:
+    using self = fixed_genotype_model;
+    using representation = std::array<T, N>;
+    using value_type = T;
+    using gene_params = typename genotype_model<T>::gene_params;
+    using crossover_operator_type = operators::crossover<self>;
+    using mutation_operator_type = operators::mutation<self>;
+    using view = genotype_view<T>;
+    using const_view = genotype_view<const T>;
+
+    static_assert(N > 0, "fixed_genotype_model requires at least one gene");
+
+public:
+    explicit fixed_genotype_model(const std::array<gene_params, N> &params): params(params)
+    {
+    }
+
+    explicit fixed_genotype_model(const gene_params &universal):
+            params(fill_params(universal, std::make_index_sequence<N>()))
+    {
+    }
+
+    gene_params &get_gene_params(const std::size_t index)
+    {
+        return params[index];
+    }
+
+    const gene_params &get_gene_params(const std::size_t index) const
+    {
+        return params[index];
+    }
+
+    static constexpr std::size_t size()
+    {
+        return N;
+    }
+
+    representation create_genotype() const
+    {
+        return representation{};
+    }
+
+    template <class Genes>
+    void randomize(Genes &&genes, random_generator &generator) const
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            const auto &p = params[i];
+            genes[i] = generator.generate_with_uniform_distribution<T>(p.min_value, p.max_value);
+        }
+    }
+
+    void set_crossover_operator(std::unique_ptr<crossover_operator_type> &&ptr)
+    {
+        crossover_operator = std::move(ptr);
+    }
+
+    void add_mutation_operator(std::unique_ptr<mutation_operator_type> &&ptr)
+    {
+        mutation_operators.push_back(std::move(ptr));
+    }
+
+    // Uses the same streams as genotype_model::seed().
+    void seed(const std::uint64_t seed_value)
+    {
+        rg.seed(seed_value, random_generator::substream(seed_value, 1));
+        if (crossover_operator)
+        {
+            crossover_operator->seed(seed_value, random_generator::substream(seed_value, 2));
+        }
+
+        for (std::size_t i = 0; i < mutation_operators.size(); ++i)
+        {
+            mutation_operators[i]->seed(seed_value, random_generator::substream(seed_value, 16 + i));
+        }
+    }
+
+    template <class Function>
+    void for_each_random_generator(Function func)
+    {
+        func(rg);
+        if (crossover_operator)
+        {
+            func(crossover_operator->get_random_generator());
+        }
+
+        for (auto &ptr : mutation_operators)
+        {
+            func(ptr->get_random_generator());
+        }
+    }
+
+    void mutate(representation &genotype)
+    {
+        auto &ptr = rg.pick_item(mutation_operators);
+        ptr->apply(*this, genotype);
+    }
+
+    void mutate(view genotype)
+    {
+        auto &ptr = rg.pick_item(mutation_operators);
+        ptr->apply(*this, genotype);
+    }
+
+    void mutate(view genotype, operators::change_set &changes)
+    {
+        auto &ptr = rg.pick_item(mutation_operators);
+        ptr->apply(*this, genotype, changes);
+    }
+
+    auto crossover(const representation &a, const representation &b)
+    {
+        return crossover_operator->apply(a, b);
+    }
+
+    void crossover(const_view a, const_view b, view first, view second)
+    {
+        crossover_operator->apply(a, b, first, second);
+    }
+
+    void crossover(const_view a, const_view b, view first, view second,
+                   operators::change_set &first_changes, operators::change_set &second_changes)
+    {
+        crossover_operator->apply(a, b, first, second, first_changes, second_changes);
+    }
+
+private:
+    template <std::size_t ...I>
+    static std::array<gene_params, N> fill_params(const gene_params &universal, std::index_sequence<I...>)
+    {
+        return {{(static_cast<void>(I), universal)...}};
+    }
+
+private:
+    std::array<gene_params, N> params;
+    std::unique_ptr<crossover_operator_type> crossover_operator;
+    std::vector<std::unique_ptr<mutation_operator_type>> mutation_operators;
+    random_generator rg;
+};
+
+} // namespace ga
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "genotype_view.hpp"
+#include "genotype_batch.hpp"
+
 #include <cstddef>
 #include <functional>
 
@@ -14,5 +17,15 @@ using rank_distribution = std::function<double(std::size_t)>;
 template <class Genotype>
 using fitness = std::function<double(const Genotype &)>;
 
+template <class T>
+using view_fitness = std::function<double(genotype_view<const T>)>;
+
+// Output range of fitness values, one per genotype of the batch.
+using fitness_scores = genotype_view<double>;
+
+// Evaluates the whole batch at once and writes fitness of the i-th genotype into scores[i].
+template <class Storage>
+using batch_fitness = std::function<void(const genotype_batch<Storage> &, fitness_scores)>;
+
 } // functions
 } // namespace ga
@@ -12,24 +12,55 @@
 #include "random_generator.hpp"
 #include "detail/detail.hpp"
 #include "genotype_model.hpp"
+#include "fixed_genotype_model.hpp"
 #include "population.hpp"
+#include "operators/selection.hpp"
+#include "storage/vector_storage.hpp"
+#include "storage/flat_storage.hpp"
+#include "storage/double_buffered_storage.hpp"
+#include "storage/slab_allocator.hpp"
 #include "functions.hpp"
 #include "statistics.hpp"
 #include "logging/logger.hpp"
+#include "thread_pool.hpp"
+#include "fitness_cache.hpp"
+#include "checkpoint.hpp"
+#include "cancellation.hpp"
 
 #include <vector>
 #include <cstddef>
 #include <chrono>
 #include <algorithm>
 #include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <iterator>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
 
 
 namespace ga
 {
 
+enum class selection_method
+{
+    ranking_groups,
+    truncation,
+    tournament,
+    stochastic_universal_sampling
+};
+
+
+enum class evolution_mode
+{
+    generational,
+    steady_state // offspring replace individuals in place, see population::evolve_steady_state()
+};
+
+
 struct parameters
 {
     parameters(): population_size(500),
@@ -37,7 +68,19 @@ struct parameters
                   desired_fitness_cap(0.9),
                   time_limit(std::chrono::milliseconds(5000)),
                   ranking_groups_number(5),
-                  gather_generations_statistics(false)
+                  gather_generations_statistics(false),
+                  generations_history_limit(0),
+                  generations_history_mode(history_mode::ring),
+                  fitness_evaluation_threads(1),
+                  fitness_evaluation_chunk_size(0),
+                  fitness_cache_size(0),
+                  fitness_cache_eviction(cache_eviction_policy::lru),
+                  selection(selection_method::ranking_groups),
+                  survivors_fraction(0.5),
+                  tournament_size(2),
+                  random_seed(0),
+                  checkpoint_interval(0),
+                  evolution(evolution_mode::generational)
     {
 
     }
@@ -48,17 +91,69 @@ struct parameters
     std::chrono::milliseconds time_limit;
     std::size_t ranking_groups_number;
     bool gather_generations_statistics;
+    std::size_t generations_history_limit; // records of generations kept in statistics, 0 - all
+    history_mode generations_history_mode;
+    std::size_t fitness_evaluation_threads; // 0 - use all hardware threads, 1 - evaluate serially
+    std::size_t fitness_evaluation_chunk_size; // 0 - choose automatically
+    std::size_t fitness_cache_size; // 0 - fitness values are not cached
+    cache_eviction_policy fitness_cache_eviction;
+    selection_method selection;
+    double survivors_fraction; // share of the generation kept by all selection methods except ranking groups
+    std::size_t tournament_size;
+    std::uint64_t random_seed; // 0 - seed from std::random_device, otherwise runs are reproducible
+    std::string checkpoint_path; // empty - checkpoints are not written
+    std::size_t checkpoint_interval; // generations between checkpoints, 0 - only the final one is written
+    evolution_mode evolution; // in the steady state mode a generation is population_size offspring
+    steady_state_options steady_state; // selection parameters above are not used in the steady state mode
 };
 
 
-template <class GenotypeModel>
+// Creates the selection engine chosen by `params.selection`.
+inline std::unique_ptr<operators::selection> create_selection(const parameters &params,
+                                                             const functions::rank_distribution &rank_function)
+{
+    switch (params.selection)
+    {
+        case selection_method::truncation:
+            return std::make_unique<operators::truncation_selection>(params.survivors_fraction);
+        case selection_method::tournament:
+            return std::make_unique<operators::tournament_selection>(params.survivors_fraction,
+                                                                     params.tournament_size);
+        case selection_method::stochastic_universal_sampling:
+            return std::make_unique<operators::stochastic_universal_sampling>(params.survivors_fraction);
+        case selection_method::ranking_groups:
+        default:
+            return std::make_unique<operators::ranking_groups_selection>(params.ranking_groups_number,
+                                                                         rank_function);
+    }
+}
+
+
+// State of a run which can be read while the run continues, see algorithm::get_progress().
+template <class Genotype>
+struct run_progress
+{
+    std::size_t generations = 0;
+    double best_achieved_fitness = 0;
+    long long milliseconds_passed = 0;
+    Genotype best_genotype; // best one of all generations passed, see has_best_genotype
+    bool has_best_genotype = false; // false before the first generation
+    statistics::generation_record last_generation;
+    bool is_finished = false;
+};
+
+
+template <class GenotypeModel, class Storage = vector_storage<GenotypeModel>>
 class algorithm
 {
 public:
     using genotype_representation = typename GenotypeModel::representation;
-    using population_type = population<GenotypeModel>;
-    using fitness_function_type = functions::fitness<genotype_representation>;
+    using population_type = population<GenotypeModel, Storage>;
+    using fitness_function_type = typename population_type::fitness_function;
+    using batch_fitness_function_type = typename population_type::batch_fitness_function;
+    using incremental_fitness_type = typename population_type::incremental_fitness_type;
     using loggers_type = std::vector<std::unique_ptr<logging::logger>>;
+    using progress_type = run_progress<genotype_representation>;
 
 public:
     algorithm(const std::shared_ptr<GenotypeModel> &model,
@@ -69,32 +164,186 @@ public:
             rank_distribution_function(rank_distribution_function),
             num_of_generations_passed(0),
             best_achieved_fitness(0),
-            time_passed(0)
+            time_passed(0),
+            cancellation(nullptr),
+            shared_progress(std::make_shared<progress_state>())
     {
 
     }
 
+    // The batch function evaluates whole chunks of the generation at once and
+    // is used instead of the per-genotype fitness function when it is set.
+    void set_batch_fitness_function(batch_fitness_function_type func)
+    {
+        batch_fitness_function = std::move(func);
+    }
+
+    // Children are evaluated by updating the fitness of their parents. Takes precedence
+    // over both the per-genotype and the batch fitness functions.
+    void set_incremental_fitness(const std::shared_ptr<incremental_fitness_type> &func)
+    {
+        incremental_fitness_function = func;
+    }
+
     population_type run(const parameters& params, const loggers_type &loggers = {})
+    {
+        population_type population(model.lock(), params.population_size);
+        prepare(population, params);
+        population.init();
+
+        num_of_generations_passed = 0;
+        time_passed = std::chrono::milliseconds(0);
+        stats.set_best_achieved_fitness(0);
+        evolve(population, params, loggers);
+        return population;
+    }
+
+    // Continues the run saved to `checkpoint_path` by a run with the same model, fitness function
+    // and population size. The time limit and the generations limit count the time and generations
+    // passed before the checkpoint. Throws std::runtime_error if the checkpoint cannot be loaded.
+    population_type run(const parameters& params, const std::string &checkpoint_path, const loggers_type &loggers = {})
+    {
+        population_type population(model.lock(), params.population_size);
+        prepare(population, params);
+
+        const detail::mapped_file file(checkpoint_path);
+        checkpoint_counters counters;
+        if (!file.is_open() || !read_checkpoint(file.get_data(), file.get_size(), population, counters))
+        {
+            throw std::runtime_error("cannot load checkpoint " + checkpoint_path);
+        }
+
+        num_of_generations_passed = static_cast<std::size_t>(counters.generations);
+        time_passed = std::chrono::milliseconds(counters.milliseconds_passed);
+        stats.set_best_achieved_fitness(counters.best_achieved_fitness);
+        stats.set_milliseconds_passed(counters.milliseconds_passed);
+        evolve(population, params, loggers);
+        return population;
+    }
+
+
+    // Stops when `token` is cancelled, possibly in the middle of a generation. The interrupted
+    // generation is not counted and the population is left as population::is_interrupted() tells.
+    population_type run(const parameters& params, const cancellation_token &token, const loggers_type &loggers = {})
+    {
+        cancellation = &token;
+        auto population = run(params, loggers);
+        cancellation = nullptr;
+        return population;
+    }
+
+    // Runs on a new thread. The algorithm must not be used otherwise until the run finishes,
+    // except for get_progress().
+    std::future<population_type> run_async(const parameters &params,
+                                           cancellation_token token = cancellation_token(),
+                                           loggers_type loggers = {})
+    {
+        return std::async(std::launch::async, [this, params, token](const loggers_type &loggers) {
+            return run(params, token, loggers);
+        }, std::move(loggers));
+    }
+
+    // Can be called from any thread while the algorithm runs. Updated after every generation.
+    progress_type get_progress() const
+    {
+        std::lock_guard<std::mutex> lock(shared_progress->mutex);
+        return shared_progress->progress;
+    }
+
+    const statistics &get_statistics() const
+    {
+        return stats;
+    }
+
+private:
+    struct progress_state
+    {
+        std::mutex mutex;
+        progress_type progress;
+    };
+
+    void publish_progress(const population_type &population)
+    {
+        const auto &best = population.get_best_genotype();
+        std::lock_guard<std::mutex> lock(shared_progress->mutex);
+        auto &progress = shared_progress->progress;
+        if (!progress.has_best_genotype || best_achieved_fitness > progress.best_achieved_fitness)
+        {
+            progress.best_achieved_fitness = best_achieved_fitness;
+            progress.best_genotype = detail::make_genotype<genotype_representation>(best.begin(), best.end());
+            progress.has_best_genotype = true;
+        }
+        progress.generations = num_of_generations_passed;
+        progress.milliseconds_passed = time_passed.count();
+        progress.last_generation = stats.get_last_generation_stats();
+    }
+
+    void prepare(population_type &population, const parameters &params)
     {
         if (params.gather_generations_statistics)
         {
-            stats.reserve_generation_stats_space(1024);
+            stats.set_generations_history(params.generations_history_limit, params.generations_history_mode);
+        }
+        population.enable_fitness_summary(params.gather_generations_statistics);
+        stats.reset_phase_statistics();
+        {
+            std::lock_guard<std::mutex> lock(shared_progress->mutex);
+            shared_progress->progress = progress_type();
         }
 
-        population_type population(model.lock(), params.population_size);
-        population.init();
+        population.set_selection(create_selection(params, rank_distribution_function));
+        if (params.random_seed != 0)
+        {
+            population.seed(params.random_seed);
+        }
+    }
 
-        const auto start_time = std::chrono::steady_clock::now();
-        time_passed = std::chrono::milliseconds(0);
+    void evolve(population_type &population, const parameters &params, const loggers_type &loggers)
+    {
+        population.enable_fitness_cache(params.fitness_cache_size, params.fitness_cache_eviction);
+        population.set_batch_fitness_function(batch_fitness_function);
+        population.set_incremental_fitness(incremental_fitness_function);
+        population.set_cancellation_token(cancellation);
 
-        num_of_generations_passed = 0;
-        best_achieved_fitness = 0.0;
+        std::unique_ptr<thread_pool> pool;
+        const std::size_t threads_count = params.fitness_evaluation_threads == 0 ?
+                                          std::thread::hardware_concurrency() :
+                                          params.fitness_evaluation_threads;
+        if (threads_count > 1)
+        {
+            pool = std::make_unique<thread_pool>(threads_count);
+            population.set_thread_pool(pool.get(), params.fitness_evaluation_chunk_size);
+        }
+
+        std::unique_ptr<checkpoint_writer> checkpoints;
+        std::vector<unsigned char> checkpoint_buffer;
+        if (!params.checkpoint_path.empty())
+        {
+            checkpoints = std::make_unique<checkpoint_writer>(params.checkpoint_path);
+        }
+
+        // Time passed before a restored checkpoint is counted too.
+        const auto start_time = std::chrono::steady_clock::now() - time_passed;
+        best_achieved_fitness = stats.get_best_achieved_fitness();
 
         while (params.generations_limit > num_of_generations_passed &&
                params.desired_fitness_cap > best_achieved_fitness &&
-               params.time_limit > time_passed)
+               params.time_limit > time_passed &&
+               !(cancellation != nullptr && cancellation->is_cancelled()))
         {
-            population.evolve(fitness_function, rank_distribution_function, params.ranking_groups_number);
+            if (params.evolution == evolution_mode::steady_state)
+            {
+                population.evolve_steady_state(fitness_function, params.population_size, params.steady_state);
+            }
+            else
+            {
+                population.evolve(fitness_function, rank_distribution_function, params.ranking_groups_number);
+            }
+
+            if (population.is_interrupted())
+            {
+                break;
+            }
             best_achieved_fitness = population.get_best_achieved_fitness();
 
             const auto now = std::chrono::steady_clock::now();
@@ -104,7 +353,15 @@ public:
             // stats collection:
             stats.set_best_achieved_fitness(best_achieved_fitness);
             stats.set_milliseconds_passed(time_passed.count());
-            stats.add_generation_stats_entry(num_of_generations_passed, best_achieved_fitness);
+            stats.set_generation_phases(population.get_phase_statistics());
+            stats.add_generation_stats_entry(num_of_generations_passed, best_achieved_fitness,
+                                             population.get_fitness_summary());
+            if (const auto cache = population.get_fitness_cache())
+            {
+                stats.set_fitness_cache_counters(cache->get_hits_count(), cache->get_misses_count());
+            }
+
+            publish_progress(population);
 
             // logging output:
             for (auto &logger_ptr : loggers)
@@ -112,25 +369,58 @@ public:
                 auto &logger = *logger_ptr;
                 logger(stats);
             }
+
+            // Skipped if the previous checkpoint is still being written.
+            if (checkpoints && params.checkpoint_interval > 0 &&
+                num_of_generations_passed % params.checkpoint_interval == 0)
+            {
+                write_checkpoint(checkpoint_buffer, population, current_counters());
+                checkpoints->try_submit(checkpoint_buffer);
+            }
         }
 
-        return population;
-    }
+        // An interrupted generation is half done, so the last checkpoint written stays.
+        if (checkpoints && !population.is_interrupted())
+        {
+            checkpoints->flush();
+            write_checkpoint(checkpoint_buffer, population, current_counters());
+            checkpoints->try_submit(checkpoint_buffer);
+            checkpoints->flush();
+        }
+        else if (checkpoints)
+        {
+            checkpoints->flush();
+        }
 
+        for (auto &logger_ptr : loggers)
+        {
+            logger_ptr->flush();
+        }
 
-    const statistics &get_statistics() const
+        population.set_thread_pool(nullptr);
+        population.set_cancellation_token(nullptr);
+
+        std::lock_guard<std::mutex> lock(shared_progress->mutex);
+        shared_progress->progress.is_finished = true;
+    }
+
+    checkpoint_counters current_counters() const
     {
-        return stats;
+        return checkpoint_counters{num_of_generations_passed, best_achieved_fitness, time_passed.count()};
     }
 
 private:
     std::weak_ptr<GenotypeModel> model;
     fitness_function_type fitness_function;
+    batch_fitness_function_type batch_fitness_function;
+    std::shared_ptr<incremental_fitness_type> incremental_fitness_function;
     functions::rank_distribution rank_distribution_function;
     std::chrono::milliseconds time_passed;
     std::size_t num_of_generations_passed;
     double best_achieved_fitness;
     statistics stats;
+    const cancellation_token *cancellation;
+    std::shared_ptr<progress_state> shared_progress;
 };
 
 }
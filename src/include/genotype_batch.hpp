@@ -0,0 +1,63 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+
+
+namespace ga
+{
+
+// Range of genotypes of a population storage which are evaluated together.
+// Besides element access it exposes the storage and the indices of the genotypes,
+// so evaluators can work directly with the memory layout of the storage.
+template <class Storage>
+class genotype_batch
+{
+public:
+    using const_reference = typename Storage::const_reference;
+
+public:
+    genotype_batch(const Storage &storage, const std::size_t *indices, const std::size_t count):
+            storage(&storage),
+            indices(indices),
+            count(count)
+    {
+    }
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    const_reference operator[](const std::size_t position) const
+    {
+        return (*storage)[indices[position]];
+    }
+
+    // Index of the genotype at `position` in the storage.
+    std::size_t index(const std::size_t position) const
+    {
+        return indices[position];
+    }
+
+    const Storage &get_storage() const
+    {
+        return *storage;
+    }
+
+private:
+    const Storage *storage;
+    const std::size_t *indices;
+    std::size_t count;
+};
+
+} // namespace ga
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "random_generator.hpp"
+#include "genotype_view.hpp"
 #include <memory>
+#include <cstddef>
+#include <cstdint>
 
 
 namespace ga
@@ -15,31 +18,51 @@ public:
     using gene_value_type = typename Model::value_type;
 
 public:
-    genotype_constructor(const std::shared_ptr<Model> &model): model(model)
+    genotype_constructor(const std::shared_ptr<Model> &model): model(model),
+                                                               is_seeded(false),
+                                                               seed_value(0)
     {
     }
 
-    genotype_representation construct_random() const
+    // Every genotype is then constructed from its own stream chosen by the genotype index.
+    void seed(const std::uint64_t value)
     {
-        random_generator rg;
-        genotype_representation result;
+        is_seeded = true;
+        seed_value = value;
+    }
 
+    genotype_representation construct_random(const std::size_t index = 0) const
+    {
+        random_generator rg = make_generator(index);
         auto _model = model.lock();
+        genotype_representation result = _model->create_genotype();
+        _model->randomize(result, rg);
+
+        return result;
+    }
 
-        result.reserve(_model->size());
+    void construct_random(genotype_view<gene_value_type> genes, const std::size_t index = 0) const
+    {
+        random_generator rg = make_generator(index);
+        model.lock()->randomize(genes, rg);
+    }
 
-        for (std::size_t i = 0; i < _model->size(); ++i)
+private:
+    random_generator make_generator(const std::size_t index) const
+    {
+        if (!is_seeded)
         {
-            auto gene_params = _model->get_gene_params(i);
-            auto value = rg.generate_with_uniform_distribution<gene_value_type>(gene_params.min_value, gene_params.max_value);
-            result.push_back(value);
+            return random_generator();
         }
 
-        return result;
+        const auto constructor_stream = random_generator::substream(seed_value, 5);
+        return random_generator(seed_value, random_generator::substream(constructor_stream, index));
     }
 
 private:
     std::weak_ptr<Model> model;
+    bool is_seeded;
+    std::uint64_t seed_value;
 };
 
 } // namespace ga
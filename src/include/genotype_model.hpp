@@ -9,23 +9,29 @@
 #include "operators/crossover.hpp"
 #include "operators/mutation.hpp"
 #include "random_generator.hpp"
+#include "genotype_view.hpp"
 
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 
 namespace ga
 {
 
-template<class T>
+// Genotypes are vectors allocated by `Allocator`, e.g. slab_allocator to keep them in a pool.
+template<class T, class Allocator = std::allocator<T>>
 class genotype_model
 {
 public:
     using self = genotype_model;
-    using representation = std::vector<T>;
+    using allocator_type = Allocator;
+    using representation = std::vector<T, Allocator>;
     using value_type = T;
     using crossover_operator_type = operators::crossover<self>;
     using mutation_operator_type = operators::mutation<self>;
+    using view = genotype_view<T>;
+    using const_view = genotype_view<const T>;
 
     struct gene_params
     {
@@ -54,11 +60,14 @@ public:
     };
 
 public:
-    genotype_model(const std::vector <gene_params> &params) : params(params)
+    genotype_model(const std::vector <gene_params> &params, const Allocator &allocator = Allocator()):
+            params(params),
+            allocator(allocator)
     {
     }
 
-    genotype_model(const gene_params &universal, const std::size_t _size)
+    genotype_model(const gene_params &universal, const std::size_t _size, const Allocator &allocator = Allocator()):
+            allocator(allocator)
     {
         params = std::vector<gene_params>{_size, universal};
     }
@@ -78,6 +87,28 @@ public:
         return params.size();
     }
 
+    const Allocator &get_allocator() const
+    {
+        return allocator;
+    }
+
+    // Genotype of the model length with default genes, allocated by the model allocator.
+    representation create_genotype() const
+    {
+        return representation(params.size(), allocator);
+    }
+
+    // Fills `genes` with values drawn uniformly within the bounds of every gene.
+    template <class Genes>
+    void randomize(Genes &&genes, random_generator &generator) const
+    {
+        for (std::size_t i = 0; i < genes.size(); ++i)
+        {
+            const auto &p = params[i];
+            genes[i] = generator.generate_with_uniform_distribution<T>(p.min_value, p.max_value);
+        }
+    }
+
     void set_crossover_operator(std::unique_ptr<crossover_operator_type> &&ptr)
     {
         crossover_operator = std::move(ptr);
@@ -88,6 +119,38 @@ public:
         mutation_operators.push_back(std::move(ptr));
     }
 
+    // Makes the model and its operators draw random numbers from reproducible streams.
+    void seed(const std::uint64_t seed_value)
+    {
+        rg.seed(seed_value, random_generator::substream(seed_value, 1));
+        if (crossover_operator)
+        {
+            crossover_operator->seed(seed_value, random_generator::substream(seed_value, 2));
+        }
+
+        for (std::size_t i = 0; i < mutation_operators.size(); ++i)
+        {
+            mutation_operators[i]->seed(seed_value, random_generator::substream(seed_value, 16 + i));
+        }
+    }
+
+    // Calls `func` for the generator of the model and the generators of its operators
+    // in a fixed order.
+    template <class Function>
+    void for_each_random_generator(Function func)
+    {
+        func(rg);
+        if (crossover_operator)
+        {
+            func(crossover_operator->get_random_generator());
+        }
+
+        for (auto &ptr : mutation_operators)
+        {
+            func(ptr->get_random_generator());
+        }
+    }
+
     void mutate(representation &genotype)
     {
 //        for (auto &mut_op : mutation_operators)
@@ -104,13 +167,37 @@ public:
         ptr->apply(*this, genotype);
     }
 
+    void mutate(view genotype)
+    {
+        auto &ptr = rg.pick_item(mutation_operators);
+        ptr->apply(*this, genotype);
+    }
+
     auto crossover(const representation &a, const representation &b)
     {
         return crossover_operator->apply(a, b);
     }
 
+    void crossover(const_view a, const_view b, view first, view second)
+    {
+        crossover_operator->apply(a, b, first, second);
+    }
+
+    void mutate(view genotype, operators::change_set &changes)
+    {
+        auto &ptr = rg.pick_item(mutation_operators);
+        ptr->apply(*this, genotype, changes);
+    }
+
+    void crossover(const_view a, const_view b, view first, view second,
+                   operators::change_set &first_changes, operators::change_set &second_changes)
+    {
+        crossover_operator->apply(a, b, first, second, first_changes, second_changes);
+    }
+
 private:
     std::vector<gene_params> params;
+    Allocator allocator;
     std::unique_ptr<crossover_operator_type> crossover_operator;
     std::vector<std::unique_ptr<mutation_operator_type>> mutation_operators;
     random_generator rg;
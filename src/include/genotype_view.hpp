@@ -0,0 +1,175 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+
+namespace ga
+{
+
+template <class T>
+class genotype_view;
+
+
+template <class T>
+struct is_genotype_view : std::false_type
+{
+};
+
+template <class T>
+struct is_genotype_view<genotype_view<T>> : std::true_type
+{
+};
+
+
+// Non-owning view of genes stored with a constant distance between them.
+// Genotypes of contiguous representations have stride 1, genotypes stored
+// in the transposed (gene-major) layout of genome_matrix have stride equal
+// to the number of genotypes.
+template <class T>
+class genotype_view
+{
+public:
+    using value_type = std::remove_const_t<T>;
+    using reference = T &;
+    using pointer = T *;
+    using size_type = std::size_t;
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+
+    public:
+        iterator(): ptr(nullptr), step(1)
+        {
+        }
+
+        iterator(T *ptr, const std::ptrdiff_t step): ptr(ptr), step(step)
+        {
+        }
+
+        reference operator*() const { return *ptr; }
+        pointer operator->() const { return ptr; }
+        reference operator[](const difference_type n) const { return ptr[n * step]; }
+
+        iterator &operator++() { ptr += step; return *this; }
+        iterator &operator--() { ptr -= step; return *this; }
+        iterator operator++(int) { iterator it = *this; ptr += step; return it; }
+        iterator operator--(int) { iterator it = *this; ptr -= step; return it; }
+        iterator &operator+=(const difference_type n) { ptr += n * step; return *this; }
+        iterator &operator-=(const difference_type n) { ptr -= n * step; return *this; }
+        iterator operator+(const difference_type n) const { return iterator(ptr + n * step, step); }
+        iterator operator-(const difference_type n) const { return iterator(ptr - n * step, step); }
+        friend iterator operator+(const difference_type n, const iterator &it) { return it + n; }
+        difference_type operator-(const iterator &other) const { return (ptr - other.ptr) / step; }
+
+        bool operator==(const iterator &other) const { return ptr == other.ptr; }
+        bool operator!=(const iterator &other) const { return ptr != other.ptr; }
+        bool operator<(const iterator &other) const { return ptr < other.ptr; }
+        bool operator>(const iterator &other) const { return ptr > other.ptr; }
+        bool operator<=(const iterator &other) const { return ptr <= other.ptr; }
+        bool operator>=(const iterator &other) const { return ptr >= other.ptr; }
+
+    private:
+        T *ptr;
+        std::ptrdiff_t step;
+    };
+
+    using const_iterator = iterator;
+
+public:
+    genotype_view(): first(nullptr), length(0), distance(1)
+    {
+    }
+
+    genotype_view(T *data, const std::size_t size, const std::size_t stride = 1):
+            first(data),
+            length(size),
+            distance(stride)
+    {
+    }
+
+    // Views contiguous containers like std::vector and std::array.
+    template <class Container,
+              class = std::enable_if_t<!is_genotype_view<std::remove_const_t<Container>>::value &&
+                                       std::is_convertible<decltype(std::declval<Container &>().data()), T *>::value>>
+    genotype_view(Container &container):
+            genotype_view(container.data(), container.size())
+    {
+    }
+
+    template <class U, class = std::enable_if_t<std::is_same<const U, T>::value>>
+    genotype_view(const genotype_view<U> &other):
+            genotype_view(other.data(), other.size(), other.stride())
+    {
+    }
+
+    std::size_t size() const
+    {
+        return length;
+    }
+
+    bool empty() const
+    {
+        return length == 0;
+    }
+
+    std::size_t stride() const
+    {
+        return distance;
+    }
+
+    bool is_contiguous() const
+    {
+        return distance == 1;
+    }
+
+    T *data() const
+    {
+        return first;
+    }
+
+    reference operator[](const std::size_t index) const
+    {
+        return first[index * distance];
+    }
+
+    iterator begin() const
+    {
+        return iterator(first, static_cast<std::ptrdiff_t>(distance));
+    }
+
+    iterator end() const
+    {
+        return iterator(first + length * distance, static_cast<std::ptrdiff_t>(distance));
+    }
+
+    iterator cbegin() const
+    {
+        return begin();
+    }
+
+    iterator cend() const
+    {
+        return end();
+    }
+
+private:
+    T *first;
+    std::size_t length;
+    std::size_t distance;
+};
+
+} // namespace ga
@@ -0,0 +1,43 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "operators/change_set.hpp"
+
+#include <vector>
+
+
+namespace ga
+{
+
+// Fitness function which can derive the fitness of a child from the fitness of its parent.
+// Every genotype has an auxiliary state (e.g. partial sums) which the evaluator fills in
+// and which is handed over from parents to children. Methods may be called concurrently
+// for different genotypes.
+template <class Storage>
+class incremental_fitness
+{
+public:
+    using const_reference = typename Storage::const_reference;
+    using state_type = std::vector<double>;
+
+public:
+    // Evaluates the genotype from scratch and fills its state.
+    virtual double evaluate(const_reference genotype, state_type &state) const = 0;
+
+    // Evaluates the genotype which may differ from `parent` only in genes listed in `changes`.
+    // `state` holds a copy of the parent state and has to be updated to the state of the genotype.
+    // Listed genes may also be equal to the parent ones.
+    virtual double update(const_reference genotype,
+                          const_reference parent,
+                          const double parent_fitness,
+                          state_type &state,
+                          const operators::change_set &changes) const = 0;
+
+    virtual ~incremental_fitness() {}
+};
+
+} // namespace ga
@@ -0,0 +1,253 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Measurements of the phases of the evolution. They are only taken when GA_INSTRUMENTATION
+// is defined, otherwise all of the functions below are empty and compiled out.
+//
+// Allocated bytes are counted by the global operator new. A program which replaces it calls
+// count_allocation(), otherwise GA_INSTRUMENTATION_COUNT_ALLOCATIONS is defined before
+// including this header in exactly one translation unit to replace it with a counting one.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(GA_INSTRUMENTATION_COUNT_ALLOCATIONS)
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#endif
+
+
+namespace ga
+{
+
+// Work done during one generation. Everything stays zero unless instrumentation is enabled.
+struct phase_statistics
+{
+    std::uint64_t fitness_nanoseconds = 0;
+    std::uint64_t selection_nanoseconds = 0;
+    std::uint64_t reproduction_nanoseconds = 0;
+    std::uint64_t fitness_evaluations = 0; // calls of the fitness function, cache hits excluded
+    std::uint64_t crossovers = 0;
+    std::uint64_t mutations = 0; // mutations which changed a gene
+    std::uint64_t bytes_allocated = 0; // by the thread running the evolution
+
+    phase_statistics &operator+=(const phase_statistics &other)
+    {
+        fitness_nanoseconds += other.fitness_nanoseconds;
+        selection_nanoseconds += other.selection_nanoseconds;
+        reproduction_nanoseconds += other.reproduction_nanoseconds;
+        fitness_evaluations += other.fitness_evaluations;
+        crossovers += other.crossovers;
+        mutations += other.mutations;
+        bytes_allocated += other.bytes_allocated;
+        return *this;
+    }
+};
+
+
+namespace instrumentation
+{
+
+#if defined(GA_INSTRUMENTATION)
+const bool is_enabled = true;
+#else
+const bool is_enabled = false;
+#endif
+
+
+namespace detail
+{
+
+inline std::uint64_t &mutations_counter()
+{
+    thread_local std::uint64_t count = 0;
+    return count;
+}
+
+inline std::uint64_t &allocated_bytes_counter()
+{
+    thread_local std::uint64_t count = 0;
+    return count;
+}
+
+} // namespace detail
+
+
+inline void count(std::uint64_t &counter, const std::uint64_t value = 1)
+{
+#if defined(GA_INSTRUMENTATION)
+    counter += value;
+#else
+    (void)counter;
+    (void)value;
+#endif
+}
+
+
+// Called by mutation operators for every gene they change.
+inline void count_mutation(const std::uint64_t count = 1)
+{
+#if defined(GA_INSTRUMENTATION)
+    detail::mutations_counter() += count;
+#else
+    (void)count;
+#endif
+}
+
+
+// Called by the global operator new for every allocation.
+inline void count_allocation(const std::size_t size)
+{
+#if defined(GA_INSTRUMENTATION)
+    detail::allocated_bytes_counter() += size;
+#else
+    (void)size;
+#endif
+}
+
+
+// Adds the time of its lifetime to `nanoseconds`.
+class phase_timer
+{
+public:
+#if defined(GA_INSTRUMENTATION)
+    explicit phase_timer(std::uint64_t &nanoseconds):
+            nanoseconds(nanoseconds),
+            start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~phase_timer()
+    {
+        const auto finish = std::chrono::steady_clock::now();
+        nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count();
+    }
+
+private:
+    std::uint64_t &nanoseconds;
+    std::chrono::steady_clock::time_point start;
+#else
+    explicit phase_timer(std::uint64_t &)
+    {
+    }
+#endif
+};
+
+
+// Resets `phases` and, when destroyed, adds the mutations and allocations made by the
+// current thread in the meantime.
+class generation_scope
+{
+public:
+#if defined(GA_INSTRUMENTATION)
+    explicit generation_scope(phase_statistics &phases):
+            phases(phases),
+            mutations(detail::mutations_counter()),
+            allocated_bytes(detail::allocated_bytes_counter())
+    {
+        phases = phase_statistics();
+    }
+
+    ~generation_scope()
+    {
+        phases.mutations += detail::mutations_counter() - mutations;
+        phases.bytes_allocated += detail::allocated_bytes_counter() - allocated_bytes;
+    }
+
+private:
+    phase_statistics &phases;
+    std::uint64_t mutations;
+    std::uint64_t allocated_bytes;
+#else
+    explicit generation_scope(phase_statistics &)
+    {
+    }
+#endif
+};
+
+} // namespace instrumentation
+} // namespace ga
+
+
+#if defined(GA_INSTRUMENTATION_COUNT_ALLOCATIONS)
+
+namespace ga
+{
+namespace instrumentation
+{
+namespace detail
+{
+
+inline std::atomic<std::uint64_t> &allocations_counter()
+{
+    static std::atomic<std::uint64_t> count{0};
+    return count;
+}
+
+} // namespace detail
+
+
+// Allocations made in all threads by the operator new below, counted with or without
+// GA_INSTRUMENTATION.
+inline std::uint64_t allocations_count()
+{
+    return detail::allocations_counter().load(std::memory_order_relaxed);
+}
+
+} // namespace instrumentation
+} // namespace ga
+
+
+// Kept out of line, otherwise GCC sees free() called on memory from operator new where
+// operator delete is inlined and reports mismatched allocation functions.
+#if defined(__GNUC__)
+#define GA_ALLOCATION_FUNCTION __attribute__((noinline))
+#else
+#define GA_ALLOCATION_FUNCTION
+#endif
+
+GA_ALLOCATION_FUNCTION void *operator new(const std::size_t size)
+{
+    ga::instrumentation::detail::allocations_counter().fetch_add(1, std::memory_order_relaxed);
+    ga::instrumentation::count_allocation(size);
+    if (void *ptr = std::malloc(size > 0 ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+GA_ALLOCATION_FUNCTION void *operator new[](const std::size_t size)
+{
+    return operator new(size);
+}
+
+GA_ALLOCATION_FUNCTION void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+GA_ALLOCATION_FUNCTION void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+GA_ALLOCATION_FUNCTION void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+GA_ALLOCATION_FUNCTION void operator delete[](void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+#undef GA_ALLOCATION_FUNCTION
+
+#endif
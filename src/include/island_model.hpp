@@ -0,0 +1,318 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "ga.hpp"
+#include "detail/spsc_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace ga
+{
+
+enum class migration_topology
+{
+    ring,
+    fully_connected,
+    random
+};
+
+
+struct island_parameters
+{
+    island_parameters(): islands_count(0),
+                         topology(migration_topology::ring),
+                         migration_interval(10),
+                         migrants_count(2),
+                         mailbox_capacity(4)
+    {
+    }
+
+    std::size_t islands_count; // 0 - one island per hardware thread
+    migration_topology topology;
+    std::size_t migration_interval; // generations between migrations, 0 - islands do not migrate
+    std::size_t migrants_count; // best survivors sent in one migration
+    std::size_t mailbox_capacity; // migrations waiting per connection, further ones are dropped
+};
+
+
+// Evolves several populations, each on its own thread, which exchange their best genotypes.
+// Islands never wait for each other: migrants are passed through lock-free single producer
+// single consumer mailboxes, one per connection of the topology, and are picked up by the
+// receiving island after its next generation. The calling thread evolves the first island
+// and reports the aggregated progress to the loggers; generations are counted by it.
+//
+// Every island gets its own model from the factory, since models own their operators.
+// Stopping conditions apply to every island; reaching the fitness cap stops all of them.
+// With a seed every island is reproducible on its own, but the moments migrants arrive
+// depend on scheduling.
+template <class GenotypeModel, class Storage = vector_storage<GenotypeModel>>
+class island_model
+{
+public:
+    using genotype_representation = typename GenotypeModel::representation;
+    using population_type = population<GenotypeModel, Storage>;
+    using fitness_function_type = typename population_type::fitness_function;
+    using model_factory_type = std::function<std::shared_ptr<GenotypeModel>()>;
+    using loggers_type = std::vector<std::unique_ptr<logging::logger>>;
+
+public:
+    island_model(model_factory_type model_factory,
+                 fitness_function_type fitness_function,
+                 functions::rank_distribution rank_distribution_function):
+            model_factory(std::move(model_factory)),
+            fitness_function(std::move(fitness_function)),
+            rank_distribution_function(std::move(rank_distribution_function))
+    {
+    }
+
+    // `params.fitness_evaluation_threads` is ignored, islands are evaluated serially.
+    // Returns populations of all islands.
+    std::vector<population_type> run(const parameters &params,
+                                     const island_parameters &island_params,
+                                     const loggers_type &loggers = {})
+    {
+        if (params.gather_generations_statistics)
+        {
+            stats.set_generations_history(params.generations_history_limit, params.generations_history_mode);
+        }
+
+        const std::size_t count = std::max<std::size_t>(island_params.islands_count == 0 ?
+                                                        std::thread::hardware_concurrency() :
+                                                        island_params.islands_count, 1);
+
+        std::vector<population_type> populations;
+        populations.reserve(count);
+        islands = std::vector<island>(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            populations.emplace_back(model_factory(), params.population_size);
+            setup_island(populations.back(), islands[i], i, params);
+        }
+        connect(island_params);
+
+        start_time = std::chrono::steady_clock::now();
+        stop = false;
+
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            threads.emplace_back([this, &populations, &params, &island_params, i] {
+                evolve_island(populations[i], i, params, island_params, nullptr);
+            });
+        }
+
+        evolve_island(populations[0], 0, params, island_params, &loggers);
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        aggregate_progress();
+        for (auto &logger_ptr : loggers)
+        {
+            logger_ptr->flush();
+        }
+
+        return populations;
+    }
+
+    const statistics &get_statistics() const
+    {
+        return stats;
+    }
+
+private:
+    using packet = std::vector<genotype_representation>;
+    using mailbox = detail::spsc_queue<packet>;
+
+    struct island
+    {
+        std::atomic<double> best_fitness{0};
+        std::atomic<std::size_t> migrants_sent{0};
+        std::atomic<std::size_t> migrants_dropped{0};
+        std::size_t generations = 0;
+        std::vector<mailbox *> outgoing;
+        std::vector<mailbox *> incoming;
+        random_generator rg;
+
+        // Keeps counters of neighbouring islands on different cache lines.
+        char padding[64];
+    };
+
+    void setup_island(population_type &p, island &state, const std::size_t index, const parameters &params)
+    {
+        p.set_selection(create_selection(params, rank_distribution_function));
+        if (params.random_seed != 0)
+        {
+            const std::uint64_t island_seed = random_generator::substream(params.random_seed, index);
+            p.seed(island_seed);
+            state.rg.seed(island_seed, random_generator::substream(island_seed, 6));
+        }
+        p.init();
+        p.enable_fitness_cache(params.fitness_cache_size, params.fitness_cache_eviction);
+    }
+
+    void connect(const island_parameters &island_params)
+    {
+        const std::size_t count = islands.size();
+        mailboxes.clear();
+
+        const auto add = [&](const std::size_t from, const std::size_t to) {
+            mailboxes.push_back(std::make_unique<mailbox>(std::max<std::size_t>(island_params.mailbox_capacity, 1)));
+            islands[from].outgoing.push_back(mailboxes.back().get());
+            islands[to].incoming.push_back(mailboxes.back().get());
+        };
+
+        for (std::size_t from = 0; from < count; ++from)
+        {
+            if (island_params.topology == migration_topology::ring)
+            {
+                if (count > 1) add(from, (from + 1) % count);
+                continue;
+            }
+
+            for (std::size_t to = 0; to < count; ++to)
+            {
+                if (to != from) add(from, to);
+            }
+        }
+    }
+
+    void evolve_island(population_type &p, const std::size_t index, const parameters &params,
+                       const island_parameters &island_params, const loggers_type *loggers)
+    {
+        auto &state = islands[index];
+        fitness_function_type fitness = fitness_function;
+        functions::rank_distribution rank_function = rank_distribution_function;
+        packet elites;
+        packet outgoing;
+        packet migrants;
+
+        double best_fitness = 0;
+        std::chrono::milliseconds time_passed(0);
+        while (!stop.load(std::memory_order_relaxed) &&
+               params.generations_limit > state.generations &&
+               params.desired_fitness_cap > best_fitness &&
+               params.time_limit > time_passed)
+        {
+            p.evolve(fitness, rank_function, params.ranking_groups_number);
+            best_fitness = p.get_best_achieved_fitness();
+            ++state.generations;
+
+            if (island_params.migration_interval > 0 && state.generations % island_params.migration_interval == 0)
+            {
+                emigrate(p, state, island_params, elites, outgoing);
+            }
+
+            for (auto *box : state.incoming)
+            {
+                while (box->try_pop(migrants))
+                {
+                    p.inject_migrants(migrants);
+                }
+            }
+
+            state.best_fitness.store(best_fitness, std::memory_order_relaxed);
+            if (best_fitness >= params.desired_fitness_cap)
+            {
+                stop.store(true, std::memory_order_relaxed);
+            }
+
+            time_passed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start_time);
+
+            if (loggers != nullptr)
+            {
+                aggregate_progress();
+                stats.add_generation_stats_entry(state.generations, stats.get_best_achieved_fitness());
+                for (auto &logger_ptr : *loggers)
+                {
+                    auto &logger = *logger_ptr;
+                    logger(stats);
+                }
+            }
+        }
+    }
+
+    void emigrate(population_type &p, island &state, const island_parameters &island_params,
+                  packet &elites, packet &outgoing)
+    {
+        if (state.outgoing.empty())
+        {
+            return;
+        }
+
+        p.copy_elites(island_params.migrants_count, elites);
+
+        if (island_params.topology == migration_topology::random)
+        {
+            send(state, state.rg.pick_item(state.outgoing), elites, outgoing);
+            return;
+        }
+
+        for (auto *box : state.outgoing)
+        {
+            send(state, box, elites, outgoing);
+        }
+    }
+
+    // `outgoing` gets back whatever the mailbox slot held before, so buffers circulate.
+    static void send(island &state, mailbox *box, const packet &elites, packet &outgoing)
+    {
+        outgoing = elites;
+        if (box->try_push(outgoing))
+        {
+            state.migrants_sent.fetch_add(elites.size(), std::memory_order_relaxed);
+        }
+        else
+        {
+            state.migrants_dropped.fetch_add(elites.size(), std::memory_order_relaxed);
+        }
+    }
+
+    void aggregate_progress()
+    {
+        double best_fitness = 0;
+        std::size_t sent = 0;
+        std::size_t dropped = 0;
+        for (const auto &state : islands)
+        {
+            best_fitness = std::max(best_fitness, state.best_fitness.load(std::memory_order_relaxed));
+            sent += state.migrants_sent.load(std::memory_order_relaxed);
+            dropped += state.migrants_dropped.load(std::memory_order_relaxed);
+        }
+
+        const auto time_passed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start_time);
+
+        stats.set_best_achieved_fitness(best_fitness);
+        stats.set_milliseconds_passed(time_passed.count());
+        stats.set_migration_counters(sent, dropped);
+    }
+
+private:
+    model_factory_type model_factory;
+    fitness_function_type fitness_function;
+    functions::rank_distribution rank_distribution_function;
+    std::vector<island> islands;
+    std::vector<std::unique_ptr<mailbox>> mailboxes;
+    std::atomic<bool> stop{false};
+    std::chrono::steady_clock::time_point start_time;
+    statistics stats;
+};
+
+} // namespace ga
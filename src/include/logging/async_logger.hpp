@@ -0,0 +1,206 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "logger.hpp"
+#include "../detail/spsc_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace ga
+{
+namespace logging
+{
+
+struct async_logger_options
+{
+    async_logger_options(): every_nth(1),
+                            max_rate(0),
+                            improvements_only(false),
+                            capacity(1024),
+                            drain_interval(std::chrono::milliseconds(10))
+    {
+    }
+
+    std::size_t every_nth; // only generations with indices divisible by it are logged
+    double max_rate; // maximum records per second, 0 - unlimited
+    bool improvements_only; // only generations which improve the best fitness are logged
+    std::size_t capacity; // records waiting for the background thread, further ones are dropped
+    std::chrono::milliseconds drain_interval; // how long the background thread sleeps when idle
+};
+
+
+// Passes sampled generation records to other loggers on a background thread. The evolution
+// thread only filters records and pushes them into a lock-free ring; when the ring is full
+// records are dropped and counted instead of waiting. Wrapped loggers see statistics
+// holding the last record and the best fitness of the records passed so far.
+class async_logger : public logger
+{
+public:
+    async_logger(list_of_loggers_type loggers, const async_logger_options &options = async_logger_options()):
+            loggers(std::move(loggers)),
+            options(options),
+            records(std::max<std::size_t>(options.capacity, 1)),
+            last_logged_fitness(0),
+            has_logged(false),
+            pushed_count(0),
+            drained_count(0),
+            dropped_count(0),
+            is_stopping(false),
+            worker([this] { drain(); })
+    {
+    }
+
+    async_logger(std::unique_ptr<logger> &&inner, const async_logger_options &options = async_logger_options()):
+            async_logger(make_list(std::move(inner)), options)
+    {
+    }
+
+    ~async_logger() override
+    {
+        is_stopping.store(true, std::memory_order_release);
+        worker.join();
+    }
+
+    void operator()(const statistics &stat) override
+    {
+        auto record = stat.get_last_generation_stats();
+        if (!is_sampled(record))
+        {
+            return;
+        }
+
+        if (records.try_push(record))
+        {
+            pushed_count.fetch_add(1, std::memory_order_release);
+        }
+        else
+        {
+            dropped_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Waits until the background thread passes all pushed records to the wrapped loggers.
+    void flush() override
+    {
+        const std::size_t pushed = pushed_count.load(std::memory_order_acquire);
+        while (drained_count.load(std::memory_order_acquire) < pushed)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // Records which did not fit into the ring.
+    std::size_t get_dropped_count() const
+    {
+        return dropped_count.load(std::memory_order_relaxed);
+    }
+
+private:
+    static list_of_loggers_type make_list(std::unique_ptr<logger> &&inner)
+    {
+        list_of_loggers_type result;
+        result.push_back(std::move(inner));
+        return result;
+    }
+
+    bool is_sampled(const statistics::generation_record &record)
+    {
+        if (options.every_nth > 1 && record.generation_index % options.every_nth != 0)
+        {
+            return false;
+        }
+
+        if (options.improvements_only && has_logged && record.best_achieved_fitness <= last_logged_fitness)
+        {
+            return false;
+        }
+
+        if (options.max_rate > 0)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (has_logged && std::chrono::duration<double>(now - last_logged_time).count() * options.max_rate < 1.0)
+            {
+                return false;
+            }
+            last_logged_time = now;
+        }
+
+        has_logged = true;
+        last_logged_fitness = record.best_achieved_fitness;
+        return true;
+    }
+
+    void drain()
+    {
+        statistics stat;
+        statistics::generation_record record;
+
+        for (;;)
+        {
+            // Records pushed before the stop request are still passed on.
+            const bool is_last = is_stopping.load(std::memory_order_acquire);
+
+            std::size_t count = 0;
+            while (records.try_pop(record))
+            {
+                stat.set_best_achieved_fitness(std::max(stat.get_best_achieved_fitness(), record.best_achieved_fitness));
+                stat.set_generation_phases(record.phases);
+                stat.add_generation_stats_entry(record.generation_index, record.best_achieved_fitness, record.summary);
+                for (auto &logger_ptr : loggers)
+                {
+                    auto &l = *logger_ptr;
+                    l(stat);
+                }
+                ++count;
+            }
+
+            if (count > 0)
+            {
+                for (auto &logger_ptr : loggers)
+                {
+                    logger_ptr->flush();
+                }
+                drained_count.fetch_add(count, std::memory_order_release);
+            }
+            else if (is_last)
+            {
+                return;
+            }
+            else
+            {
+                std::this_thread::sleep_for(options.drain_interval);
+            }
+        }
+    }
+
+private:
+    list_of_loggers_type loggers;
+    async_logger_options options;
+    detail::spsc_queue<statistics::generation_record> records;
+
+    // Used only by the thread calling operator().
+    double last_logged_fitness;
+    std::chrono::steady_clock::time_point last_logged_time;
+    bool has_logged;
+
+    std::atomic<std::size_t> pushed_count;
+    std::atomic<std::size_t> drained_count;
+    std::atomic<std::size_t> dropped_count;
+    std::atomic<bool> is_stopping;
+    std::thread worker;
+};
+
+} // namespace logging
+} // namespace ga
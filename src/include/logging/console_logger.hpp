@@ -16,7 +16,25 @@ public:
     {
         const auto &generation_statistics = stat.get_last_generation_stats();
         std::cout << generation_statistics.generation_index << " : "
-                  << generation_statistics.best_achieved_fitness << std::endl;
+                  << generation_statistics.best_achieved_fitness;
+
+        if (instrumentation::is_enabled)
+        {
+            const auto &phases = generation_statistics.phases;
+            std::cout << " (fitness " << phases.fitness_nanoseconds
+                      << " ns, selection " << phases.selection_nanoseconds
+                      << " ns, reproduction " << phases.reproduction_nanoseconds
+                      << " ns, " << phases.fitness_evaluations << " evaluations, "
+                      << phases.crossovers << " crossovers, " << phases.mutations << " mutations, "
+                      << phases.bytes_allocated << " bytes allocated)";
+        }
+
+        std::cout << '\n';
+    }
+
+    void flush() override
+    {
+        std::cout.flush();
     }
 };
 
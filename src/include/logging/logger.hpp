@@ -2,6 +2,7 @@
 
 #include "../statistics.hpp"
 #include <memory>
+#include <vector>
 
 
 namespace ga
@@ -13,6 +14,10 @@ class logger
 {
 public:
     virtual void operator()(const statistics &stat) = 0;
+
+    // Called when the run is over or a batch of records is logged.
+    virtual void flush() {}
+
     virtual ~logger() {}
 };
 
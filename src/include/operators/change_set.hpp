@@ -0,0 +1,103 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+
+namespace ga
+{
+namespace operators
+{
+
+// Indices of genes in which a child may differ from one of its parents.
+// When the number of changes exceeds the limit, or an operator cannot tell
+// what it changed, the set becomes complete: the child has to be evaluated from scratch.
+class change_set
+{
+public:
+    enum class parent
+    {
+        first,
+        second
+    };
+
+public:
+    change_set(): reference(parent::first),
+                  limit(std::numeric_limits<std::size_t>::max()),
+                  complete(false)
+    {
+    }
+
+    void reset(const parent reference_parent, const std::size_t max_changes)
+    {
+        indices.clear();
+        reference = reference_parent;
+        limit = max_changes;
+        complete = false;
+    }
+
+    void add(const std::size_t index)
+    {
+        if (complete)
+        {
+            return;
+        }
+
+        if (indices.size() >= limit)
+        {
+            mark_complete();
+            return;
+        }
+
+        indices.push_back(index);
+    }
+
+    void mark_complete()
+    {
+        complete = true;
+        indices.clear();
+    }
+
+    // Sorts indices and removes duplicates left by several operators touching the same gene.
+    void normalize()
+    {
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    }
+
+    bool is_complete() const
+    {
+        return complete;
+    }
+
+    parent get_reference_parent() const
+    {
+        return reference;
+    }
+
+    std::size_t get_limit() const
+    {
+        return limit;
+    }
+
+    const std::vector<std::size_t> &get_indices() const
+    {
+        return indices;
+    }
+
+private:
+    std::vector<std::size_t> indices;
+    parent reference;
+    std::size_t limit;
+    bool complete;
+};
+
+} // namespace operators
+} // namespace ga
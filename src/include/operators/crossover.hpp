@@ -1,8 +1,16 @@
 #pragma once
 
 #include "../detail/detail.hpp"
+#include "../detail/crossover_kernels.hpp"
 #include "../random_generator.hpp"
+#include "../genotype_view.hpp"
+#include "change_set.hpp"
 #include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <random>
+#include <type_traits>
+#include <utility>
 
 
 namespace  ga
@@ -17,9 +25,48 @@ public:
     using genotype = typename GenotypeModel::representation;
     using gene_value_type = typename GenotypeModel::value_type;
 
+    using view = genotype_view<gene_value_type>;
+    using const_view = genotype_view<const gene_value_type>;
+
 public:
     virtual std::pair<genotype, genotype> apply(const genotype &a, const genotype &b) = 0;
-    ~crossover() {}
+
+    // Writes children into storage provided by the caller. The default implementation
+    // copies the parents and goes through the allocating overload.
+    virtual void apply(const_view a, const_view b, view first, view second)
+    {
+        auto children = apply(detail::make_genotype<genotype>(a.begin(), a.end()),
+                              detail::make_genotype<genotype>(b.begin(), b.end()));
+        std::copy(children.first.cbegin(), children.first.cend(), first.begin());
+        std::copy(children.second.cbegin(), children.second.cend(), second.begin());
+    }
+
+    // Also records in which genes every child differs from one of its parents.
+    // The default implementation cannot tell that, so both sets are marked complete.
+    virtual void apply(const_view a, const_view b, view first, view second,
+                       change_set &first_changes, change_set &second_changes)
+    {
+        apply(a, b, first, second);
+        first_changes.reset(change_set::parent::first, first_changes.get_limit());
+        first_changes.mark_complete();
+        second_changes.reset(change_set::parent::second, second_changes.get_limit());
+        second_changes.mark_complete();
+    }
+
+    void seed(const std::uint64_t seed_value, const std::uint64_t stream)
+    {
+        rg.seed(seed_value, stream);
+    }
+
+    random_generator &get_random_generator()
+    {
+        return rg;
+    }
+
+    virtual ~crossover() {}
+
+protected:
+    random_generator rg;
 };
 
 
@@ -29,19 +76,282 @@ class one_point_crossover : public crossover<GenotypeModel>
 public:
     using genotype = typename GenotypeModel::representation;
     using gene_value_type = typename GenotypeModel::value_type;
+    using view = typename crossover<GenotypeModel>::view;
+    using const_view = typename crossover<GenotypeModel>::const_view;
 
 public:
     std::pair<genotype, genotype>
-    apply(const genotype &a, const genotype &b) override
+    apply(const genotype &a, const genotype &b) override final
+    {
+        return detail::one_point_crossover(a, b, pick_point(a.size()));
+    }
+
+    void apply(const_view a, const_view b, view first, view second) override final
+    {
+        detail::one_point_crossover(a, b, pick_point(a.size()), first, second);
+    }
+
+    // Every child is described relative to the parent it shares the longer part with.
+    void apply(const_view a, const_view b, view first, view second,
+               change_set &first_changes, change_set &second_changes) override final
     {
-        const std::size_t point_index =
-        rg.generate(std::uniform_int_distribution<unsigned long>(1, a.size() - 2));
+        const std::size_t size = a.size();
+        const std::size_t point_index = pick_point(size);
+        detail::one_point_crossover(a, b, point_index, first, second);
+
+        const bool tail_is_shorter = point_index >= size - point_index;
+        first_changes.reset(tail_is_shorter ? change_set::parent::first : change_set::parent::second,
+                            first_changes.get_limit());
+        second_changes.reset(tail_is_shorter ? change_set::parent::second : change_set::parent::first,
+                             second_changes.get_limit());
 
-        return detail::one_point_crossover(a, b, point_index);
+        const std::size_t begin = tail_is_shorter ? point_index : 0;
+        const std::size_t end = tail_is_shorter ? size : point_index;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            if (a[i] != b[i])
+            {
+                first_changes.add(i);
+                second_changes.add(i);
+            }
+        }
     }
 
 private:
-    random_generator rg;
+    std::size_t pick_point(const std::size_t size)
+    {
+        return this->rg.generate(std::uniform_int_distribution<unsigned long>(1, size - 2));
+    }
+};
+
+
+// Takes every gene from either parent with equal probability. The choices are drawn as a bit
+// mask for the whole genotype at once, contiguous genotypes are crossed with vector kernels.
+template <class GenotypeModel>
+class uniform_crossover : public crossover<GenotypeModel>
+{
+public:
+    using genotype = typename GenotypeModel::representation;
+    using view = typename crossover<GenotypeModel>::view;
+    using const_view = typename crossover<GenotypeModel>::const_view;
+
+public:
+    std::pair<genotype, genotype> apply(const genotype &a, const genotype &b) override final
+    {
+        std::pair<genotype, genotype> children(a, b);
+        cross(a, b, children.first, children.second);
+        return children;
+    }
+
+    void apply(const_view a, const_view b, view first, view second) override final
+    {
+        cross(a, b, first, second);
+    }
+
+    // Every child is described relative to the parent it took the genes of the set bits from.
+    void apply(const_view a, const_view b, view first, view second,
+               change_set &first_changes, change_set &second_changes) override final
+    {
+        cross(a, b, first, second);
+
+        first_changes.reset(change_set::parent::first, first_changes.get_limit());
+        second_changes.reset(change_set::parent::second, second_changes.get_limit());
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            if (!detail::test_bit(bits.data(), i) && a[i] != b[i])
+            {
+                first_changes.add(i);
+                second_changes.add(i);
+            }
+        }
+    }
+
+private:
+    void cross(const_view a, const_view b, view first, view second)
+    {
+        const std::size_t size = a.size();
+        detail::random_bits(this->rg, bits, size);
+
+        if (a.is_contiguous() && b.is_contiguous() && first.is_contiguous() && second.is_contiguous())
+        {
+            detail::uniform_crossover(a.data(), b.data(), first.data(), second.data(), size, bits.data());
+            return;
+        }
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const bool from_a = detail::test_bit(bits.data(), i);
+            first[i] = from_a ? a[i] : b[i];
+            second[i] = from_a ? b[i] : a[i];
+        }
+    }
+
+private:
+    std::vector<std::uint32_t> bits;
+};
+
+
+// Exchanges the segments of the parents between two points chosen at random. Genotypes of two
+// genes exchange their last genes, and shorter ones are copied.
+template <class GenotypeModel>
+class two_point_crossover : public crossover<GenotypeModel>
+{
+public:
+    using genotype = typename GenotypeModel::representation;
+    using view = typename crossover<GenotypeModel>::view;
+    using const_view = typename crossover<GenotypeModel>::const_view;
+
+public:
+    std::pair<genotype, genotype> apply(const genotype &a, const genotype &b) override final
+    {
+        std::pair<genotype, genotype> children(a, b);
+        const auto points = pick_points(a.size());
+        cross(a, b, children.first, children.second, points.first, points.second);
+        return children;
+    }
+
+    void apply(const_view a, const_view b, view first, view second) override final
+    {
+        const auto points = pick_points(a.size());
+        cross(a, b, first, second, points.first, points.second);
+    }
+
+    // Every child is described relative to the parent it shares the longer part with.
+    void apply(const_view a, const_view b, view first, view second,
+               change_set &first_changes, change_set &second_changes) override final
+    {
+        const std::size_t size = a.size();
+        const auto points = pick_points(size);
+        cross(a, b, first, second, points.first, points.second);
+
+        const bool middle_is_shorter = points.second - points.first <= size - (points.second - points.first);
+        first_changes.reset(middle_is_shorter ? change_set::parent::first : change_set::parent::second,
+                            first_changes.get_limit());
+        second_changes.reset(middle_is_shorter ? change_set::parent::second : change_set::parent::first,
+                             second_changes.get_limit());
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const bool is_middle = i >= points.first && i < points.second;
+            if (is_middle == middle_is_shorter && a[i] != b[i])
+            {
+                first_changes.add(i);
+                second_changes.add(i);
+            }
+        }
+    }
+
+private:
+    // Points in [1, size - 1], the first one is less than the second one.
+    std::pair<std::size_t, std::size_t> pick_points(const std::size_t size)
+    {
+        if (size < 3)
+        {
+            return size == 2 ? std::make_pair<std::size_t, std::size_t>(1, 2) : std::make_pair(size, size);
+        }
+
+        const std::size_t x = this->rg.generate(std::uniform_int_distribution<std::size_t>(1, size - 1));
+        std::size_t y = this->rg.generate(std::uniform_int_distribution<std::size_t>(1, size - 2));
+        if (y >= x) ++y;
+
+        return x < y ? std::make_pair(x, y) : std::make_pair(y, x);
+    }
+
+    static void cross(const_view a, const_view b, view first, view second,
+                      const std::size_t begin, const std::size_t end)
+    {
+        copy(a, first, 0, begin);
+        copy(b, second, 0, begin);
+        copy(b, first, begin, end);
+        copy(a, second, begin, end);
+        copy(a, first, end, a.size());
+        copy(b, second, end, a.size());
+    }
+
+    static void copy(const_view from, view to, const std::size_t begin, const std::size_t end)
+    {
+        if (from.is_contiguous() && to.is_contiguous())
+        {
+            std::copy(from.data() + begin, from.data() + end, to.data() + begin);
+            return;
+        }
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            to[i] = from[i];
+        }
+    }
+};
+
+
+// Blends the genes chosen by a random bit mask: the first child gets a + w * (b - a) and the
+// second one b + w * (a - b) with the weight w drawn uniformly from [0, 1) for every pair,
+// the other genes stay as in the parents. Integral genes are rounded to the nearest value.
+template <class GenotypeModel>
+class blend_crossover : public crossover<GenotypeModel>
+{
+public:
+    using genotype = typename GenotypeModel::representation;
+    using gene_value_type = typename GenotypeModel::value_type;
+    using view = typename crossover<GenotypeModel>::view;
+    using const_view = typename crossover<GenotypeModel>::const_view;
+
+    static_assert(std::is_arithmetic<gene_value_type>::value, "blend_crossover requires arithmetic genes");
+
+public:
+    std::pair<genotype, genotype> apply(const genotype &a, const genotype &b) override final
+    {
+        std::pair<genotype, genotype> children(a, b);
+        cross(a, b, children.first, children.second);
+        return children;
+    }
+
+    void apply(const_view a, const_view b, view first, view second) override final
+    {
+        cross(a, b, first, second);
+    }
+
+    // Every child is described relative to its own parent.
+    void apply(const_view a, const_view b, view first, view second,
+               change_set &first_changes, change_set &second_changes) override final
+    {
+        cross(a, b, first, second);
+
+        first_changes.reset(change_set::parent::first, first_changes.get_limit());
+        second_changes.reset(change_set::parent::second, second_changes.get_limit());
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            if (detail::test_bit(bits.data(), i) && a[i] != b[i])
+            {
+                first_changes.add(i);
+                second_changes.add(i);
+            }
+        }
+    }
+
+private:
+    void cross(const_view a, const_view b, view first, view second)
+    {
+        const std::size_t size = a.size();
+        const double weight = this->rg.generate(std::uniform_real_distribution<double>(0, 1));
+        detail::random_bits(this->rg, bits, size);
+
+        if (a.is_contiguous() && b.is_contiguous() && first.is_contiguous() && second.is_contiguous())
+        {
+            detail::blend_crossover(a.data(), b.data(), first.data(), second.data(), size, bits.data(), weight);
+            return;
+        }
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const bool is_blended = detail::test_bit(bits.data(), i);
+            first[i] = is_blended ? detail::blend_gene(a[i], b[i], weight, std::is_integral<gene_value_type>()) : a[i];
+            second[i] = is_blended ? detail::blend_gene(b[i], a[i], weight, std::is_integral<gene_value_type>()) : b[i];
+        }
+    }
+
+private:
+    std::vector<std::uint32_t> bits;
 };
 
 } //namespace operators
@@ -1,6 +1,15 @@
 #pragma once
 
+#include "../detail/detail.hpp"
 #include "../random_generator.hpp"
+#include "../genotype_view.hpp"
+#include "change_set.hpp"
+#include "../instrumentation.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <random>
+#include <vector>
 
 
 namespace  ga
@@ -14,6 +23,7 @@ class mutation
 public:
     using genotype = typename GenotypeModel::representation;
     using gene_value_type = typename GenotypeModel::value_type;
+    using view = genotype_view<gene_value_type>;
 
 public:
     mutation(double probability = 0) : probability(probability)
@@ -22,6 +32,23 @@ public:
 
     virtual void apply(const GenotypeModel &model, genotype &g) = 0;
 
+    // Mutates genes in storage which is not owned by a genotype. The default implementation
+    // goes through a temporary genotype.
+    virtual void apply(const GenotypeModel &model, view g)
+    {
+        genotype tmp = detail::make_genotype<genotype>(g.begin(), g.end());
+        apply(model, tmp);
+        std::copy(tmp.cbegin(), tmp.cend(), g.begin());
+    }
+
+    // Also adds indices of changed genes to `changes`. The default implementation
+    // cannot tell them, so the set is marked complete.
+    virtual void apply(const GenotypeModel &model, view g, change_set &changes)
+    {
+        apply(model, g);
+        changes.mark_complete();
+    }
+
     double get_probability() const
     {
         return probability;
@@ -32,7 +59,17 @@ public:
         probability = p;
     }
 
-    ~mutation() {}
+    void seed(const std::uint64_t seed_value, const std::uint64_t stream)
+    {
+        rg.seed(seed_value, stream);
+    }
+
+    random_generator &get_random_generator()
+    {
+        return rg;
+    }
+
+    virtual ~mutation() {}
 
 protected:
     bool will_apply(const GenotypeModel &model, const std::size_t gene_index)
@@ -42,7 +79,9 @@ protected:
         if (p < 0.0) p = 0.0;
         std::bernoulli_distribution bd(p);
 
-        return rg.generate(bd);
+        const bool result = rg.generate(bd);
+        if (result) instrumentation::count_mutation();
+        return result;
     }
 
 protected:
@@ -60,6 +99,9 @@ public:
     using genotype = typename GenotypeModel::representation;
     using gene_value_type = typename GenotypeModel::value_type;
 
+public:
+    using view = typename mutation<GenotypeModel>::view;
+
 public:
     random_value_mutation(double probability):
             mutation<GenotypeModel>(probability)
@@ -67,13 +109,35 @@ public:
     }
 
     void apply(const GenotypeModel &model, genotype &g) override final
+    {
+        mutate(model, g);
+    }
+
+    void apply(const GenotypeModel &model, view g) override final
+    {
+        mutate(model, g);
+    }
+
+    void apply(const GenotypeModel &model, view g, change_set &changes) override final
+    {
+        const std::size_t index = mutate(model, g);
+        if (index < g.size()) changes.add(index);
+    }
+
+private:
+    // Returns index of the mutated gene or the size of the genotype if it was not mutated.
+    template <class Genes>
+    std::size_t mutate(const GenotypeModel &model, Genes &g)
     {
         const std::size_t index = this->rg.generate(std::uniform_int_distribution<unsigned long>(0, g.size() - 1));
         if (this->will_apply(model, index))
         {
             const auto &gene_params = model.get_gene_params(index);
             g[index] = this->rg.generate(Distribution(gene_params.min_value, gene_params.max_value));
+            return index;
         }
+
+        return g.size();
     }
 };
 
@@ -85,6 +149,9 @@ public:
     using genotype = typename GenotypeModel::representation;
     using gene_value_type = typename GenotypeModel::value_type;
 
+public:
+    using view = typename mutation<GenotypeModel>::view;
+
 public:
     random_value_shift_mutation(double probability):
             mutation<GenotypeModel>(probability)
@@ -92,6 +159,25 @@ public:
     }
 
     void apply(const GenotypeModel &model, genotype &g) override final
+    {
+        mutate(model, g);
+    }
+
+    void apply(const GenotypeModel &model, view g) override final
+    {
+        mutate(model, g);
+    }
+
+    void apply(const GenotypeModel &model, view g, change_set &changes) override final
+    {
+        const std::size_t index = mutate(model, g);
+        if (index < g.size()) changes.add(index);
+    }
+
+private:
+    // Returns index of the mutated gene or the size of the genotype if it was not mutated.
+    template <class Genes>
+    std::size_t mutate(const GenotypeModel &model, Genes &g)
     {
         const std::size_t index = this->rg.generate(std::uniform_int_distribution<unsigned long>(0, g.size() - 1));
         if (this->will_apply(model, index))
@@ -110,50 +196,269 @@ public:
 
             if (gene > gene_params.max_value) gene = gene_params.max_value;
             if (gene < gene_params.min_value) gene = gene_params.min_value;
+            return index;
+        }
+
+        return g.size();
+    }
+};
+
+// Mutates every gene with probability `probability * mutation_probability_multiplier`.
+// At sparse rates gaps between candidate genes are drawn from the geometric distribution for
+// the highest gene rate of the model and each candidate is accepted with the ratio of its own
+// rate to the highest one, so the cost follows the expected number of mutations rather than the
+// genome length. At dense rates blocks of raw draws are compared with per-gene thresholds
+// in a loop the compiler vectorizes.
+template <class GenotypeModel>
+class per_gene_mutation : public mutation<GenotypeModel>
+{
+public:
+    // Rates at or above `dense_rate` use the block path, and so does a rate of 1 whatever
+    // `dense_rate` is, since then every gene is a candidate.
+    per_gene_mutation(double probability, double dense_rate = 0.125):
+            mutation<GenotypeModel>(probability),
+            dense_rate(dense_rate),
+            rates_model(nullptr),
+            rates_probability(0),
+            max_rate(0),
+            is_uniform(true)
+    {
+    }
+
+    // Gene rates are cached for the model, so they have to be reset after its gene parameters change.
+    void reset_rates()
+    {
+        rates_model = nullptr;
+    }
+
+protected:
+    // Calls `mutate_gene(index)` for every gene chosen to be mutated in increasing order of indices.
+    template <class Function>
+    void for_each_mutated_gene(const GenotypeModel &model, const std::size_t size, Function mutate_gene)
+    {
+        update_rates(model, size);
+        if (max_rate <= 0)
+        {
+            return;
+        }
+
+        auto counted_mutate_gene = [&mutate_gene](const std::size_t index) {
+            instrumentation::count_mutation();
+            mutate_gene(index);
+        };
+
+        if (max_rate >= dense_rate || max_rate >= 1.0)
+        {
+            for_each_in_blocks(size, counted_mutate_gene);
+        }
+        else
+        {
+            for_each_with_skips(size, counted_mutate_gene);
+        }
+    }
+
+private:
+    void update_rates(const GenotypeModel &model, const std::size_t size)
+    {
+        const double probability = this->get_probability();
+        if (rates_model == &model && thresholds.size() == size && rates_probability == probability)
+        {
+            return;
+        }
+
+        rates_model = &model;
+        rates_probability = probability;
+        thresholds.resize(size);
+        acceptance.resize(size);
+        max_rate = 0;
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            double p = probability * model.get_gene_params(i).mutation_probability_multiplier;
+            if (p > 1.0) p = 1.0;
+            if (p < 0.0) p = 0.0;
+            acceptance[i] = p;
+            // A rate of 1 gives 2^32, which is above any 32-bit draw.
+            thresholds[i] = static_cast<std::uint64_t>(std::ldexp(p, 32));
+            max_rate = std::max(max_rate, p);
+        }
+
+        is_uniform = true;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            acceptance[i] = max_rate > 0 ? acceptance[i] / max_rate : 0;
+            if (acceptance[i] < 1.0) is_uniform = false;
+        }
+
+        // Otherwise the gaps are not used.
+        if (max_rate > 0 && max_rate < 1.0)
+        {
+            gaps = std::geometric_distribution<std::size_t>(max_rate);
         }
     }
+
+    template <class Function>
+    void for_each_in_blocks(const std::size_t size, Function &mutate_gene)
+    {
+        constexpr std::size_t block_size = 64;
+        auto &engine = this->rg.get_engine();
+        std::uint32_t draws[block_size];
+        unsigned char hits[block_size];
+
+        for (std::size_t begin = 0; begin < size; begin += block_size)
+        {
+            const std::size_t length = std::min(block_size, size - begin);
+            const std::uint64_t *block_thresholds = thresholds.data() + begin;
+
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                draws[i] = engine();
+            }
+
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                hits[i] = draws[i] < block_thresholds[i];
+            }
+
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                if (hits[i]) mutate_gene(begin + i);
+            }
+        }
+    }
+
+    template <class Function>
+    void for_each_with_skips(const std::size_t size, Function &mutate_gene)
+    {
+        std::uniform_real_distribution<double> accept;
+        for (std::size_t index = this->rg.generate(gaps); index < size; )
+        {
+            if (is_uniform || this->rg.generate(accept) < acceptance[index])
+            {
+                mutate_gene(index);
+            }
+
+            const std::size_t gap = this->rg.generate(gaps);
+            if (gap >= size - index)
+            {
+                break;
+            }
+            index += gap + 1;
+        }
+    }
+
+private:
+    double dense_rate;
+    const GenotypeModel *rates_model;
+    double rates_probability;
+    std::vector<std::uint64_t> thresholds;
+    std::vector<double> acceptance;
+    double max_rate;
+    bool is_uniform;
+    std::geometric_distribution<std::size_t> gaps;
 };
 
-/*
-class permutation_operator : public mutation_operator
+
+template <class GenotypeModel, class Distribution>
+class per_gene_random_value_mutation : public per_gene_mutation<GenotypeModel>
 {
 public:
-    permutation_operator(double probability, std::size_t max_distance, std::size_t min_distance):
-            mutation_operator(probability),
-            max_distance(max_distance),
-            min_distance(min_distance)
+    using genotype = typename GenotypeModel::representation;
+    using view = typename mutation<GenotypeModel>::view;
+
+public:
+    per_gene_random_value_mutation(double probability, double dense_rate = 0.125):
+            per_gene_mutation<GenotypeModel>(probability, dense_rate)
     {
+    }
 
+    void apply(const GenotypeModel &model, genotype &g) override final
+    {
+        this->for_each_mutated_gene(model, g.size(), [&](const std::size_t index) {
+            mutate_gene(model, g, index);
+        });
     }
 
-    permutation_operator(): permutation_operator(0, 1, 1)
+    void apply(const GenotypeModel &model, view g) override final
     {
+        this->for_each_mutated_gene(model, g.size(), [&](const std::size_t index) {
+            mutate_gene(model, g, index);
+        });
+    }
 
+    void apply(const GenotypeModel &model, view g, change_set &changes) override final
+    {
+        this->for_each_mutated_gene(model, g.size(), [&](const std::size_t index) {
+            mutate_gene(model, g, index);
+            changes.add(index);
+        });
     }
 
-    void apply(genotype &g) override final
+private:
+    template <class Genes>
+    void mutate_gene(const GenotypeModel &model, Genes &g, const std::size_t index)
     {
-        const std::size_t last_index = g.size() - 1;
+        const auto &gene_params = model.get_gene_params(index);
+        g[index] = this->rg.generate(Distribution(gene_params.min_value, gene_params.max_value));
+    }
+};
 
-        std::size_t first_gene_index = 0;
-        std::size_t second_gene_index = rg.generate(std::uniform_int_distribution<unsigned long>(min_distance, max_distance));
-        std::size_t index_shift = rg.generate(std::uniform_int_distribution<unsigned long>(0, last_index));
 
-        first_gene_index = index_shift;
-        const std::size_t shifted_second_gene_index = second_gene_index + index_shift;
-        second_gene_index = shifted_second_gene_index > last_index ?
-                            shifted_second_gene_index - last_index :
-                            shifted_second_gene_index;
+template <class GenotypeModel>
+class per_gene_random_value_shift_mutation : public per_gene_mutation<GenotypeModel>
+{
+public:
+    using genotype = typename GenotypeModel::representation;
+    using view = typename mutation<GenotypeModel>::view;
 
-        g.swap_genes(first_gene_index, second_gene_index);
+public:
+    per_gene_random_value_shift_mutation(double probability, double dense_rate = 0.125):
+            per_gene_mutation<GenotypeModel>(probability, dense_rate)
+    {
+    }
+
+    void apply(const GenotypeModel &model, genotype &g) override final
+    {
+        this->for_each_mutated_gene(model, g.size(), [&](const std::size_t index) {
+            mutate_gene(model, g, index);
+        });
+    }
+
+    void apply(const GenotypeModel &model, view g) override final
+    {
+        this->for_each_mutated_gene(model, g.size(), [&](const std::size_t index) {
+            mutate_gene(model, g, index);
+        });
+    }
+
+    void apply(const GenotypeModel &model, view g, change_set &changes) override final
+    {
+        this->for_each_mutated_gene(model, g.size(), [&](const std::size_t index) {
+            mutate_gene(model, g, index);
+            changes.add(index);
+        });
     }
 
 private:
-    std::size_t max_distance;
-    std::size_t min_distance;
-    random_generator rg;
+    template <class Genes>
+    void mutate_gene(const GenotypeModel &model, Genes &g, const std::size_t index)
+    {
+        const auto &gene_params = model.get_gene_params(index);
+        std::bernoulli_distribution bd;
+        auto &gene = g[index];
+        if (this->rg.generate(bd))
+        {
+            gene += gene_params.increment;
+        }
+        else
+        {
+            gene -= gene_params.decrement;
+        }
+
+        if (gene > gene_params.max_value) gene = gene_params.max_value;
+        if (gene < gene_params.min_value) gene = gene_params.min_value;
+    }
 };
-*/
 
 } //namespace operators
 } //namespace ga
\ No newline at end of file
@@ -0,0 +1,284 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "../detail/detail.hpp"
+#include "../functions.hpp"
+#include "../random_generator.hpp"
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+
+
+namespace ga
+{
+
+struct genotype_fitness
+{
+    double fitness;
+    std::size_t index;
+
+    genotype_fitness(): fitness(0),
+                        index(0)
+    {
+    }
+
+    genotype_fitness(double fitness, std::size_t index):
+            fitness(fitness),
+            index(index)
+    {
+    }
+};
+
+
+namespace operators
+{
+
+// Chooses survivors of the generation. Every genotype is selected at most once
+// and the best one of the generation has to be the first of the selected.
+class selection
+{
+public:
+    // `candidates` may be reordered by the engine.
+    virtual void select(std::vector<genotype_fitness> &candidates, std::vector<genotype_fitness> &selected) = 0;
+
+    void seed(const std::uint64_t seed_value, const std::uint64_t stream)
+    {
+        rg.seed(seed_value, stream);
+    }
+
+    random_generator &get_random_generator()
+    {
+        return rg;
+    }
+
+    virtual ~selection() {}
+
+protected:
+    static void move_best_to_front(std::vector<genotype_fitness> &values)
+    {
+        const auto best = std::max_element(values.begin(), values.end(), [](const genotype_fitness &a,
+                                                                           const genotype_fitness &b) {
+            return a.fitness < b.fitness;
+        });
+
+        if (best != values.end())
+        {
+            std::iter_swap(values.begin(), best);
+        }
+    }
+
+    static std::size_t survivors_count(const std::size_t size, const double fraction)
+    {
+        const auto count = static_cast<std::size_t>(static_cast<double>(size) * fraction);
+        return std::min(size, std::max<std::size_t>(count, 2));
+    }
+
+protected:
+    random_generator rg;
+};
+
+
+// Sorts the generation and takes a share of every ranking group defined by the rank function.
+class ranking_groups_selection : public selection
+{
+public:
+    ranking_groups_selection(const std::size_t groups_count, functions::rank_distribution rank_function):
+            groups_count(groups_count),
+            rank_function(std::move(rank_function))
+    {
+    }
+
+    void select(std::vector<genotype_fitness> &candidates, std::vector<genotype_fitness> &selected) override final
+    {
+        std::sort(candidates.begin(), candidates.end(), [](const genotype_fitness &a, const genotype_fitness &b) {
+            return a.fitness > b.fitness;
+        });
+
+        detail::split_by_groups_and_select(candidates, groups_count, rank_function, selected);
+    }
+
+private:
+    std::size_t groups_count;
+    functions::rank_distribution rank_function;
+};
+
+
+// Keeps the given share of the best genotypes. The boundary is found by nth_element,
+// so survivors other than the best one are not ordered.
+class truncation_selection : public selection
+{
+public:
+    explicit truncation_selection(const double survivors_fraction):
+            survivors_fraction(survivors_fraction)
+    {
+    }
+
+    void select(std::vector<genotype_fitness> &candidates, std::vector<genotype_fitness> &selected) override final
+    {
+        const std::size_t count = survivors_count(candidates.size(), survivors_fraction);
+        const auto boundary = candidates.begin() + static_cast<std::ptrdiff_t>(count);
+
+        std::nth_element(candidates.begin(), boundary - 1, candidates.end(),
+                         [](const genotype_fitness &a, const genotype_fitness &b) {
+                             return a.fitness > b.fitness;
+                         });
+
+        selected.assign(candidates.begin(), boundary);
+        move_best_to_front(selected);
+    }
+
+private:
+    double survivors_fraction;
+};
+
+
+// Runs tournaments between randomly picked genotypes which have not been selected yet.
+// The best genotype of the generation is always kept.
+class tournament_selection : public selection
+{
+public:
+    tournament_selection(const double survivors_fraction, const std::size_t tournament_size):
+            survivors_fraction(survivors_fraction),
+            tournament_size(std::max<std::size_t>(tournament_size, 1))
+    {
+    }
+
+    void select(std::vector<genotype_fitness> &candidates, std::vector<genotype_fitness> &selected) override final
+    {
+        selected.clear();
+        if (candidates.empty())
+        {
+            return;
+        }
+
+        const std::size_t count = survivors_count(candidates.size(), survivors_fraction);
+
+        // Not yet selected candidates are kept in [0, remaining).
+        move_best_to_front(candidates);
+        std::size_t remaining = candidates.size();
+        take(candidates, 0, remaining, selected);
+
+        while (selected.size() < count)
+        {
+            std::uniform_int_distribution<std::size_t> d(0, remaining - 1);
+            std::size_t winner = rg.generate(d);
+            for (std::size_t i = 1; i < tournament_size; ++i)
+            {
+                const std::size_t rival = rg.generate(d);
+                if (candidates[rival].fitness > candidates[winner].fitness)
+                {
+                    winner = rival;
+                }
+            }
+
+            take(candidates, winner, remaining, selected);
+        }
+    }
+
+private:
+    static void take(std::vector<genotype_fitness> &candidates, const std::size_t position, std::size_t &remaining,
+                     std::vector<genotype_fitness> &selected)
+    {
+        selected.push_back(candidates[position]);
+        --remaining;
+        std::swap(candidates[position], candidates[remaining]);
+    }
+
+private:
+    double survivors_fraction;
+    std::size_t tournament_size;
+};
+
+
+// Stochastic universal sampling: evenly spaced pointers over the cumulative fitness
+// select genotypes proportionally to their fitness in one pass. A genotype hit by several
+// pointers survives once, and the missing survivors are the fittest genotypes not hit.
+class stochastic_universal_sampling : public selection
+{
+public:
+    explicit stochastic_universal_sampling(const double survivors_fraction):
+            survivors_fraction(survivors_fraction)
+    {
+    }
+
+    void select(std::vector<genotype_fitness> &candidates, std::vector<genotype_fitness> &selected) override final
+    {
+        selected.clear();
+        if (candidates.empty())
+        {
+            return;
+        }
+
+        const std::size_t count = survivors_count(candidates.size(), survivors_fraction);
+
+        move_best_to_front(candidates);
+        selected.push_back(candidates.front());
+
+        double total = 0;
+        for (const auto &candidate : candidates)
+        {
+            total += std::max(candidate.fitness, 0.0);
+        }
+
+        // Without positive fitness there is no wheel, so the fittest genotypes survive.
+        if (total <= 0)
+        {
+            const auto last = candidates.begin() + static_cast<std::ptrdiff_t>(count);
+            std::partial_sort(candidates.begin(), last, candidates.end(), [](const genotype_fitness &a,
+                                                                             const genotype_fitness &b) {
+                return a.fitness > b.fitness;
+            });
+            selected.assign(candidates.begin(), last);
+            return;
+        }
+
+        const double step = total / static_cast<double>(count);
+        double pointer = rg.generate(std::uniform_real_distribution<double>(0, step));
+        double cumulative = 0;
+        std::size_t pointers_left = count;
+
+        // Selected candidates are moved to the front, behind them are the candidates not hit.
+        std::size_t hit_count = 1;
+        for (std::size_t i = 0; i < candidates.size() && pointers_left > 0; ++i)
+        {
+            cumulative += std::max(candidates[i].fitness, 0.0);
+            bool is_hit = false;
+            while (pointers_left > 0 && pointer < cumulative)
+            {
+                is_hit = true;
+                pointer += step;
+                --pointers_left;
+            }
+
+            if (is_hit && i > 0 && selected.size() < count)
+            {
+                selected.push_back(candidates[i]);
+                std::swap(candidates[i], candidates[hit_count++]);
+            }
+        }
+
+        if (selected.size() < count)
+        {
+            const auto rest = candidates.begin() + static_cast<std::ptrdiff_t>(hit_count);
+            const auto missing = static_cast<std::ptrdiff_t>(count - selected.size());
+            std::partial_sort(rest, rest + missing, candidates.end(), [](const genotype_fitness &a,
+                                                                        const genotype_fitness &b) {
+                return a.fitness > b.fitness;
+            });
+            selected.insert(selected.end(), rest, rest + missing);
+        }
+    }
+
+private:
+    double survivors_fraction;
+};
+
+} // namespace operators
+} // namespace ga
@@ -0,0 +1,402 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// Genotypes which are permutations of 0, 1, ..., n - 1, e.g. orders of cities of a route.
+// The model is genotype_model<std::uint32_t> which constructs random permutations, and the
+// operators below keep genotypes permutations, so no repair is needed. The crossovers are
+// linear in the genotype length: they find genes by the index of positions of a parent and
+// mark taken genes in a bitset.
+
+#pragma once
+
+#include "genotype_model.hpp"
+#include "operators/crossover.hpp"
+#include "operators/mutation.hpp"
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+namespace ga
+{
+
+// Operators of permutations are operators of this model.
+using permutation_base_model = genotype_model<std::uint32_t>;
+
+
+class permutation_genotype_model : public permutation_base_model
+{
+public:
+    explicit permutation_genotype_model(const std::size_t size):
+            permutation_base_model(gene_params(0, static_cast<std::uint32_t>(size > 0 ? size - 1 : 0)), size)
+    {
+    }
+
+    // Shuffles genes 0, 1, ..., n - 1.
+    template <class Genes>
+    void randomize(Genes &&genes, random_generator &generator) const
+    {
+        for (std::size_t i = 0; i < genes.size(); ++i)
+        {
+            genes[i] = static_cast<value_type>(i);
+        }
+
+        for (std::size_t i = genes.size(); i > 1; --i)
+        {
+            const std::size_t j = generator.generate(std::uniform_int_distribution<std::size_t>(0, i - 1));
+            std::swap(genes[i - 1], genes[j]);
+        }
+    }
+};
+
+
+namespace permutation
+{
+
+template <class Genes>
+bool is_valid(const Genes &genes)
+{
+    std::vector<bool> seen(genes.size(), false);
+    for (std::size_t i = 0; i < genes.size(); ++i)
+    {
+        const auto gene = static_cast<std::size_t>(genes[i]);
+        if (gene >= genes.size() || seen[gene])
+        {
+            return false;
+        }
+        seen[gene] = true;
+    }
+
+    return true;
+}
+
+
+// Segment [first, second) of a genotype of `size` genes, at least one gene long.
+inline std::pair<std::size_t, std::size_t> random_segment(random_generator &rg, const std::size_t size)
+{
+    const std::size_t x = rg.generate(std::uniform_int_distribution<std::size_t>(0, size));
+    std::size_t y = rg.generate(std::uniform_int_distribution<std::size_t>(0, size - 1));
+    if (y >= x) ++y;
+
+    return x < y ? std::make_pair(x, y) : std::make_pair(y, x);
+}
+
+
+// Two different positions of a genotype of `size` genes, the first one is less.
+inline std::pair<std::size_t, std::size_t> random_positions(random_generator &rg, const std::size_t size)
+{
+    const std::size_t x = rg.generate(std::uniform_int_distribution<std::size_t>(0, size - 1));
+    std::size_t y = rg.generate(std::uniform_int_distribution<std::size_t>(0, size - 2));
+    if (y >= x) ++y;
+
+    return x < y ? std::make_pair(x, y) : std::make_pair(y, x);
+}
+
+} // namespace permutation
+
+
+namespace operators
+{
+
+// Base of the crossovers of permutations. Children are made by a cross() template of the
+// derived class for genotypes and views alike.
+template <class GenotypeModel, class Derived>
+class permutation_crossover : public crossover<GenotypeModel>
+{
+public:
+    using genotype = typename GenotypeModel::representation;
+    using view = typename crossover<GenotypeModel>::view;
+    using const_view = typename crossover<GenotypeModel>::const_view;
+
+public:
+    std::pair<genotype, genotype> apply(const genotype &a, const genotype &b) override final
+    {
+        std::pair<genotype, genotype> children(a, b);
+        static_cast<Derived *>(this)->cross(a, b, children.first, children.second);
+        return children;
+    }
+
+    void apply(const_view a, const_view b, view first, view second) override final
+    {
+        static_cast<Derived *>(this)->cross(a, b, first, second);
+    }
+
+protected:
+    // positions[gene] is the position of the gene in `genes`.
+    template <class Genes>
+    void index_positions(const Genes &genes)
+    {
+        positions.resize(genes.size());
+        for (std::size_t i = 0; i < genes.size(); ++i)
+        {
+            positions[genes[i]] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+protected:
+    std::vector<std::uint32_t> positions;
+    std::vector<bool> marks;
+};
+
+
+// Order crossover (OX): a child takes a random segment of one parent and the other genes in
+// the order they follow in the other parent from the end of the segment.
+template <class GenotypeModel>
+class order_crossover : public permutation_crossover<GenotypeModel, order_crossover<GenotypeModel>>
+{
+public:
+    template <class Parent, class Child>
+    void cross(const Parent &a, const Parent &b, Child &first, Child &second)
+    {
+        const std::size_t size = a.size();
+        const auto segment = permutation::random_segment(this->rg, size);
+        fill(a, b, first, segment.first, segment.second);
+        fill(b, a, second, segment.first, segment.second);
+    }
+
+private:
+    template <class Parent, class Child>
+    void fill(const Parent &from_segment, const Parent &from_order, Child &child,
+              const std::size_t begin, const std::size_t end)
+    {
+        const std::size_t size = from_segment.size();
+        auto &taken = this->marks;
+        taken.assign(size, false);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            child[i] = from_segment[i];
+            taken[from_segment[i]] = true;
+        }
+
+        std::size_t position = end == size ? 0 : end;
+        std::size_t source = position;
+        for (std::size_t k = 0; k < size; ++k)
+        {
+            const auto gene = from_order[source];
+            if (++source == size) source = 0;
+            if (taken[gene]) continue;
+
+            child[position] = gene;
+            if (++position == size) position = 0;
+        }
+    }
+};
+
+
+// Partially mapped crossover (PMX): a child takes a random segment of one parent and the other
+// genes at their positions in the other parent. A gene displaced by the segment goes to the
+// position found by following the mapping between the segments of the parents.
+template <class GenotypeModel>
+class partially_mapped_crossover :
+        public permutation_crossover<GenotypeModel, partially_mapped_crossover<GenotypeModel>>
+{
+public:
+    template <class Parent, class Child>
+    void cross(const Parent &a, const Parent &b, Child &first, Child &second)
+    {
+        const auto segment = permutation::random_segment(this->rg, a.size());
+        fill(a, b, first, segment.first, segment.second);
+        fill(b, a, second, segment.first, segment.second);
+    }
+
+private:
+    template <class Parent, class Child>
+    void fill(const Parent &from_segment, const Parent &from_rest, Child &child,
+              const std::size_t begin, const std::size_t end)
+    {
+        const std::size_t size = from_segment.size();
+        this->index_positions(from_rest);
+        auto &in_segment = this->marks;
+        in_segment.assign(size, false);
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            child[i] = from_rest[i];
+        }
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            child[i] = from_segment[i];
+            in_segment[from_segment[i]] = true;
+        }
+
+        // Chains of the mapping are disjoint, so every position is passed at most once.
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const auto gene = from_rest[i];
+            if (in_segment[gene]) continue;
+
+            std::size_t position = i;
+            do
+            {
+                position = this->positions[from_segment[position]];
+            }
+            while (position >= begin && position < end);
+
+            child[position] = gene;
+        }
+    }
+};
+
+
+// Cycle crossover (CX): genes are split into the cycles of positions which the parents
+// exchange among themselves, and the children take the cycles from the parents in turn,
+// so every gene keeps the position it has in one of the parents.
+template <class GenotypeModel>
+class cycle_crossover : public permutation_crossover<GenotypeModel, cycle_crossover<GenotypeModel>>
+{
+public:
+    template <class Parent, class Child>
+    void cross(const Parent &a, const Parent &b, Child &first, Child &second)
+    {
+        const std::size_t size = a.size();
+        this->index_positions(a);
+        auto &visited = this->marks;
+        visited.assign(size, false);
+
+        bool from_a = true;
+        for (std::size_t start = 0; start < size; ++start)
+        {
+            if (visited[start]) continue;
+
+            std::size_t position = start;
+            do
+            {
+                visited[position] = true;
+                first[position] = from_a ? a[position] : b[position];
+                second[position] = from_a ? b[position] : a[position];
+                position = this->positions[b[position]];
+            }
+            while (position != start);
+
+            from_a = !from_a;
+        }
+    }
+};
+
+
+// Base of the mutations of permutations. A mutation moves genes with the probability of
+// the mutation and adds the positions it changed to the change set.
+template <class GenotypeModel, class Derived>
+class permutation_mutation : public mutation<GenotypeModel>
+{
+public:
+    using genotype = typename GenotypeModel::representation;
+    using view = typename mutation<GenotypeModel>::view;
+
+public:
+    explicit permutation_mutation(const double probability): mutation<GenotypeModel>(probability)
+    {
+    }
+
+    void apply(const GenotypeModel &, genotype &g) override final
+    {
+        mutate(g, nullptr);
+    }
+
+    void apply(const GenotypeModel &, view g) override final
+    {
+        mutate(g, nullptr);
+    }
+
+    void apply(const GenotypeModel &, view g, change_set &changes) override final
+    {
+        mutate(g, &changes);
+    }
+
+private:
+    template <class Genes>
+    void mutate(Genes &g, change_set *changes)
+    {
+        if (g.size() < 2 || !this->rg.generate(std::bernoulli_distribution(this->get_probability())))
+        {
+            return;
+        }
+
+        const auto positions = permutation::random_positions(this->rg, g.size());
+        const std::size_t changed = static_cast<Derived *>(this)->move(g, positions.first, positions.second);
+        instrumentation::count_mutation(changed);
+
+        if (changes == nullptr) return;
+        if (changed == 2)
+        {
+            changes->add(positions.first);
+            changes->add(positions.second);
+            return;
+        }
+
+        for (std::size_t i = positions.first; i <= positions.second; ++i)
+        {
+            changes->add(i);
+        }
+    }
+};
+
+
+// Swaps two genes.
+template <class GenotypeModel>
+class swap_mutation : public permutation_mutation<GenotypeModel, swap_mutation<GenotypeModel>>
+{
+public:
+    using permutation_mutation<GenotypeModel, swap_mutation<GenotypeModel>>::permutation_mutation;
+
+    // Returns the number of changed genes.
+    template <class Genes>
+    std::size_t move(Genes &g, const std::size_t first, const std::size_t last)
+    {
+        std::swap(g[first], g[last]);
+        return 2;
+    }
+};
+
+
+// Moves a gene to another position, shifting the genes between them.
+template <class GenotypeModel>
+class insert_mutation : public permutation_mutation<GenotypeModel, insert_mutation<GenotypeModel>>
+{
+public:
+    using permutation_mutation<GenotypeModel, insert_mutation<GenotypeModel>>::permutation_mutation;
+
+    template <class Genes>
+    std::size_t move(Genes &g, const std::size_t first, const std::size_t last)
+    {
+        const auto begin = g.begin() + static_cast<std::ptrdiff_t>(first);
+        const auto end = g.begin() + static_cast<std::ptrdiff_t>(last + 1);
+        if (this->rg.generate(std::bernoulli_distribution(0.5)))
+        {
+            std::rotate(begin, begin + 1, end);
+        }
+        else
+        {
+            std::rotate(begin, end - 1, end);
+        }
+
+        return last - first + 1;
+    }
+};
+
+
+// Reverses the order of the genes of a segment.
+template <class GenotypeModel>
+class inversion_mutation : public permutation_mutation<GenotypeModel, inversion_mutation<GenotypeModel>>
+{
+public:
+    using permutation_mutation<GenotypeModel, inversion_mutation<GenotypeModel>>::permutation_mutation;
+
+    template <class Genes>
+    std::size_t move(Genes &g, const std::size_t first, const std::size_t last)
+    {
+        std::reverse(g.begin() + static_cast<std::ptrdiff_t>(first), g.begin() + static_cast<std::ptrdiff_t>(last + 1));
+        return last - first + 1;
+    }
+};
+
+} // namespace operators
+} // namespace ga
@@ -0,0 +1,162 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <limits>
+
+
+namespace ga
+{
+
+// Counter-based Philox4x32-10 generator (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+// Every output block is a keyed bijection of a 128-bit counter. The key is derived from the seed,
+// the upper half of the counter holds the stream number and the lower half counts blocks,
+// so streams with different numbers never overlap and are created without any setup cost.
+class philox_engine
+{
+public:
+    using result_type = std::uint32_t;
+    using key_type = std::array<std::uint32_t, 2>;
+    using counter_type = std::array<std::uint32_t, 4>;
+
+    struct state
+    {
+        key_type key;
+        counter_type counter;
+        std::uint32_t position;
+    };
+
+public:
+    philox_engine(): philox_engine(0, 0)
+    {
+    }
+
+    philox_engine(const std::uint64_t seed_value, const std::uint64_t stream)
+    {
+        seed(seed_value, stream);
+    }
+
+    static constexpr result_type min()
+    {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    void seed(const std::uint64_t seed_value, const std::uint64_t stream)
+    {
+        key = {{static_cast<std::uint32_t>(seed_value), static_cast<std::uint32_t>(seed_value >> 32)}};
+        counter = {{0, 0, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)}};
+        position = block_size;
+    }
+
+    result_type operator()()
+    {
+        if (position == block_size)
+        {
+            block = generate_block(counter, key);
+            increment_counter();
+            position = 0;
+        }
+
+        return block[position++];
+    }
+
+    // Writes the next `count` values, the same ones `count` calls would return.
+    void generate(result_type *out, std::size_t count)
+    {
+        for (; count > 0 && position < block_size; --count)
+        {
+            *out++ = block[position++];
+        }
+
+        for (; count >= block_size; count -= block_size, out += block_size)
+        {
+            const auto values = generate_block(counter, key);
+            increment_counter();
+            std::copy(values.cbegin(), values.cend(), out);
+        }
+
+        for (; count > 0; --count)
+        {
+            *out++ = (*this)();
+        }
+    }
+
+    void discard(unsigned long long n)
+    {
+        for (; n > 0; --n)
+        {
+            (*this)();
+        }
+    }
+
+    state get_state() const
+    {
+        return state{key, counter, position};
+    }
+
+    void set_state(const state &s)
+    {
+        key = s.key;
+        position = s.position;
+        if (position < block_size)
+        {
+            // The current block was produced from the previous value of the counter.
+            counter = s.counter;
+            decrement_counter();
+            block = generate_block(counter, key);
+        }
+        counter = s.counter;
+    }
+
+    static counter_type generate_block(counter_type ctr, key_type k)
+    {
+        for (unsigned round = 0; round < 10; ++round)
+        {
+            const std::uint64_t product0 = static_cast<std::uint64_t>(0xD2511F53u) * ctr[0];
+            const std::uint64_t product1 = static_cast<std::uint64_t>(0xCD9E8D57u) * ctr[2];
+
+            ctr = {{static_cast<std::uint32_t>(product1 >> 32) ^ ctr[1] ^ k[0],
+                    static_cast<std::uint32_t>(product1),
+                    static_cast<std::uint32_t>(product0 >> 32) ^ ctr[3] ^ k[1],
+                    static_cast<std::uint32_t>(product0)}};
+
+            k[0] += 0x9E3779B9u;
+            k[1] += 0xBB67AE85u;
+        }
+
+        return ctr;
+    }
+
+private:
+    static constexpr std::uint32_t block_size = 4;
+
+    void increment_counter()
+    {
+        if (++counter[0] == 0) ++counter[1];
+    }
+
+    void decrement_counter()
+    {
+        if (counter[0]-- == 0) --counter[1];
+    }
+
+private:
+    key_type key;
+    counter_type counter;
+    counter_type block;
+    std::uint32_t position;
+};
+
+} // namespace ga
@@ -3,50 +3,83 @@
 #include "detail/detail.hpp"
 #include "genotype_constructor.hpp"
 #include "functions.hpp"
+#include "thread_pool.hpp"
+#include "fitness_cache.hpp"
+#include "incremental_fitness.hpp"
+#include "operators/change_set.hpp"
+#include "operators/selection.hpp"
+#include "storage/vector_storage.hpp"
+#include "detail/serialization.hpp"
+#include "fitness_summary.hpp"
+#include "instrumentation.hpp"
+#include "cancellation.hpp"
 
 #include <cstddef>
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <cstdint>
+#include <limits>
 
 
 namespace ga
 {
 
-template <class GenotypeModel>
+// Which individual an offspring of steady-state evolution replaces.
+enum class steady_state_replacement
+{
+    worst, // the worst one of the population
+    tournament // the worst one of a few picked at random
+};
+
+
+struct steady_state_options
+{
+    std::size_t offspring_per_step = 2; // offspring created and evaluated before they replace anyone
+    steady_state_replacement replacement = steady_state_replacement::worst;
+    std::size_t tournament_size = 2; // used for choosing parents and tournament replacement
+};
+
+
+template <class GenotypeModel, class Storage = vector_storage<GenotypeModel>>
 class population
 {
 public:
     using Genotype = typename GenotypeModel::representation;
     using GenotypeConstructor = genotype_constructor<GenotypeModel>;
+    using storage_type = Storage;
+    using genotype_reference = typename Storage::const_reference;
+    using fitness_function = typename Storage::fitness_function;
+    using batch_fitness_function = functions::batch_fitness<Storage>;
+    using incremental_fitness_type = incremental_fitness<Storage>;
 
-    struct genotype_fitness
-    {
-        double fitness;
-        Genotype *genotype;
-
-        genotype_fitness(): fitness(0),
-                            genotype(nullptr)
-        {
-        }
-
-        genotype_fitness(double fitness, Genotype *ptr):
-                fitness(fitness),
-                genotype(ptr)
-        {
-        }
-    };
+    using genotype_fitness = ga::genotype_fitness;
+    using gene_value_type = typename GenotypeModel::value_type;
 
 public:
     population(const std::shared_ptr<GenotypeModel> &model, std::size_t max_size):
             max_size(max_size),
             model(model),
             constructor(model),
+            generation(model, max_size),
             best_achieved_fitness(0),
-            overall_fitness(0)
+            overall_fitness(0),
+            pool(nullptr),
+            fitness_chunk_size(0),
+            max_changes_ratio(0.5),
+            is_summary_enabled(false),
+            cancellation(nullptr),
+            interrupted(false),
+            is_steady_state(false),
+            best_slot(0),
+            fitness_sum(0)
     {
-        generation.reserve(max_size);
         fitness_values.reserve(max_size);
+        selected.reserve(max_size);
+        selected_indices.reserve(max_size);
+        ranked_survivors.reserve(max_size);
+        pending_indices.reserve(max_size);
+        pending_scores.reserve(max_size);
     }
 
 
@@ -56,85 +89,343 @@ public:
     }
 
 
-    void init()
+    // Makes construction, selection and reproduction reproducible. Seeds the model operators
+    // as well, so with the same seed the evolution does not depend on the number of threads.
+    void seed(const std::uint64_t seed_value)
     {
-        fitness_values = std::vector<genotype_fitness>(max_size);
-
-        for (std::size_t i = 0; i < max_size; ++i)
+        model->seed(seed_value);
+        constructor.seed(seed_value);
+        rg.seed(seed_value, random_generator::substream(seed_value, 3));
+        if (selection_engine)
         {
-            generation.push_back(constructor.construct_random());
+            selection_engine->seed(seed_value, random_generator::substream(seed_value, 4));
         }
     }
 
 
-    void make_selection(const std::size_t ranking_groups_number, functions::rank_distribution func)
+    void init()
+    {
+        fitness_values = std::vector<genotype_fitness>(max_size);
+        generation.init(constructor, max_size);
+        reset_lineage();
+        is_steady_state = false;
+    }
+
+
+    void make_selection(const std::size_t ranking_groups_number, const functions::rank_distribution &func)
     {
         sort_fitness_values();
-        std::vector<Genotype> new_generation;
-        new_generation.reserve(max_size);
+        detail::split_by_groups_and_select(fitness_values, ranking_groups_number, func, selected);
+        apply_selection();
+    }
+
+
+    // Selects survivors with the engine given to set_selection().
+    void make_selection()
+    {
+        fitness_values.resize(generation.size());
+        selection_engine->select(fitness_values, selected);
+        fitness_values.resize(max_size);
+        apply_selection();
+    }
+
+
+    // Replaces selection by ranking groups in evolve().
+    void set_selection(std::unique_ptr<operators::selection> &&engine)
+    {
+        selection_engine = std::move(engine);
+    }
+
 
-        const auto new_gen_ptrs = detail::split_by_groups_and_select(fitness_values, ranking_groups_number, func);
+    // Fitness evaluation is split between the threads of the pool, so the fitness
+    // function has to be safe to call concurrently. Pass nullptr to evaluate serially.
+    void set_thread_pool(thread_pool *ptr, const std::size_t chunk_size = 0)
+    {
+        pool = ptr;
+        fitness_chunk_size = chunk_size;
+    }
+
+
+    // Fitness calculation and reproduction stop early once the token is cancelled, see is_interrupted().
+    // The token must outlive its use by the population.
+    void set_cancellation_token(const cancellation_token *token)
+    {
+        cancellation = token;
+    }
+
+    // Whether the last evolve() was stopped by the cancellation token. If it was stopped in fitness
+    // calculation, genotypes which were not evaluated get the lowest fitness and fitness values are
+    // sorted, so get_best_genotype() returns the best of the evaluated ones. If it was stopped in
+    // reproduction, the generation is left with fewer genotypes.
+    bool is_interrupted() const
+    {
+        return interrupted;
+    }
 
-        for (std::size_t i = 0; i < new_gen_ptrs.size(); ++i)
+
+    // Already known fitness values are taken from the cache instead of calling the fitness function.
+    void enable_fitness_cache(const std::size_t capacity, const cache_eviction_policy policy)
+    {
+        cache = capacity > 0 ? std::make_unique<fitness_cache<Genotype>>(capacity, policy) : nullptr;
+    }
+
+    const fitness_cache<Genotype> *get_fitness_cache() const
+    {
+        return cache.get();
+    }
+
+
+    // Makes each fitness calculation summarize the distribution of fitness values as well.
+    void enable_fitness_summary(const bool enable)
+    {
+        is_summary_enabled = enable;
+        summary = fitness_summary();
+    }
+
+    // Summary of the last fitness calculation, empty unless enabled.
+    const fitness_summary &get_fitness_summary() const
+    {
+        return summary;
+    }
+
+
+    // When set, the batch function is preferred over the per-genotype fitness function.
+    void set_batch_fitness_function(batch_fitness_function func)
+    {
+        batch_function = std::move(func);
+    }
+
+
+    // Children are evaluated from the fitness and the state of the parent they are closest to,
+    // while survivors are not evaluated at all. The incremental function takes precedence over
+    // the cache and the batch function. Changes covering more than `max_changes_fraction`
+    // of the genome are evaluated from scratch.
+    void set_incremental_fitness(std::shared_ptr<incremental_fitness_type> func,
+                                 const double max_changes_fraction = 0.5)
+    {
+        incremental_function = std::move(func);
+        max_changes_ratio = max_changes_fraction;
+        if (incremental_function)
         {
-            new_generation.push_back(std::move(*(new_gen_ptrs[i].genotype)));
-            fitness_values[i].fitness = new_gen_ptrs[i].fitness;
-            fitness_values[i].genotype = &new_generation.back();
+            states.resize(max_size);
+            next_states.resize(max_size);
+            lineage.resize(max_size);
         }
-
-        generation = std::move(new_generation);
+        reset_lineage();
     }
 
 
-    void calculate_fitness(functions::fitness<Genotype> &func)
+    void calculate_fitness(fitness_function &func)
     {
-        double fitness_sum = 0;
-        best_achieved_fitness = 0;
+        interrupted = false;
+        is_steady_state = false;
+        if (incremental_function)
+        {
+            calculate_fitness_incrementally();
+            return;
+        }
+
+        pending_indices.clear();
         for (std::size_t i = 0; i < generation.size(); ++i)
         {
-            const double fitness = func(generation[i]);
-            fitness_sum += fitness;
-            fitness_values[i] = genotype_fitness(fitness, &generation[i]);
-            if (fitness > best_achieved_fitness)
-                best_achieved_fitness = fitness;
+            double fitness;
+            if (cache && cache->find(generation.as_representation(i, cache_key), fitness))
+            {
+                fitness_values[i] = genotype_fitness(fitness, i);
+            }
+            else
+            {
+                pending_indices.push_back(i);
+            }
         }
 
-        overall_fitness = fitness_sum / generation.size();
+        pending_scores.resize(pending_indices.size());
+        instrumentation::count(phases.fitness_evaluations, pending_indices.size());
+        if (pool != nullptr && pool->size() > 1)
+        {
+            pool->parallel_for(pending_indices.size(), fitness_chunk_size,
+                               [this, &func](std::size_t begin, std::size_t end, std::size_t) {
+                                   evaluate_pending(func, begin, end);
+                               });
+        }
+        else
+        {
+            evaluate_pending(func, 0, pending_indices.size());
+        }
+
+        for (std::size_t k = 0; k < pending_indices.size(); ++k)
+        {
+            fitness_values[pending_indices[k]] = genotype_fitness(pending_scores[k], pending_indices[k]);
+        }
+
+        // Cancellation is sticky, so any chunk stopped by it is noticed here.
+        interrupted = is_cancelled();
+        if (cache && !interrupted)
+        {
+            for (const auto i : pending_indices)
+            {
+                cache->insert(generation.as_representation(i, cache_key), fitness_values[i].fitness);
+            }
+        }
+
+        summarize_fitness();
+        if (interrupted)
+        {
+            sort_fitness_values();
+        }
     }
 
 
     void reproduce()
     {
-        random_generator rg;
-
         const std::size_t last_generation_member_index = size() - 1;
         const std::size_t amount = max_size - size();
+        const std::size_t max_changes = static_cast<std::size_t>(model->size() * max_changes_ratio);
 
         std::size_t first_parent = 0;
         for (std::size_t k = 0; k < amount; k += 2)
         {
-            const std::size_t second_parent = rg.generate(
+            if (k % (2 * cancellation_check_interval()) == 0 && is_cancelled())
+            {
+                interrupted = true;
+                return;
+            }
+
+            // A single survivor is crossed with itself.
+            const std::size_t second_parent = last_generation_member_index == 0 ? 0 : rg.generate(
                     std::uniform_int_distribution<std::size_t>(first_parent + 1, last_generation_member_index));
 
-            auto children = model->crossover(generation[first_parent], generation[second_parent]);
-            model->mutate(children.first);
-            model->mutate(children.second);
-
-            generation.push_back(std::move(children.first));
-            if (k + 1 < amount) generation.push_back(std::move(children.second));
-
-            ++first_parent;
+            if (incremental_function)
+            {
+                const std::size_t first_child = size();
+                const bool both = k + 1 < amount;
+                auto &first_changes = lineage[first_child].changes;
+                auto &second_changes = both ? lineage[first_child + 1].changes : spare_changes;
+                first_changes.reset(operators::change_set::parent::first, max_changes);
+                second_changes.reset(operators::change_set::parent::first, max_changes);
+
+                generation.add_children(*model, first_parent, second_parent, both, &first_changes, &second_changes);
+
+                for (std::size_t i = first_child; i < size(); ++i)
+                {
+                    const auto reference_parent = lineage[i].changes.get_reference_parent();
+                    lineage[i].fitness_is_known = false;
+                    lineage[i].parent = reference_parent == operators::change_set::parent::first ?
+                                        first_parent : second_parent;
+                }
+            }
+            else
+            {
+                generation.add_children(*model, first_parent, second_parent, k + 1 < amount);
+            }
+
+            instrumentation::count(phases.crossovers);
+
+            // Small shares of survivors are paired up several times.
+            if (++first_parent >= last_generation_member_index) first_parent = 0;
         }
     }
 
 
-    void evolve(functions::fitness<Genotype> &fitness_func,
+    // Phases are measured when instrumentation is enabled, see get_phase_statistics().
+    void evolve(fitness_function &fitness_func,
                 functions::rank_distribution &rank_func,
                 const std::size_t ranking_groups_number)
     {
-        calculate_fitness(fitness_func);
-        make_selection(ranking_groups_number, rank_func);
-        reproduce();
+        instrumentation::generation_scope scope(phases);
+        {
+            instrumentation::phase_timer timer(phases.fitness_nanoseconds);
+            calculate_fitness(fitness_func);
+        }
+        if (interrupted)
+        {
+            return;
+        }
+        {
+            instrumentation::phase_timer timer(phases.selection_nanoseconds);
+            if (selection_engine)
+            {
+                make_selection();
+            }
+            else
+            {
+                make_selection(ranking_groups_number, rank_func);
+            }
+        }
+        {
+            instrumentation::phase_timer timer(phases.reproduction_nanoseconds);
+            reproduce();
+        }
+    }
+
+    // Measurements of the last evolve() call, zero unless GA_INSTRUMENTATION is defined.
+    const phase_statistics &get_phase_statistics() const
+    {
+        return phases;
+    }
+
+
+    // Creates `count` offspring in steps of `options.offspring_per_step`. Parents are chosen by
+    // tournaments, and every offspring replaces an individual in place if it is not worse than it,
+    // so offspring of the next step already breed with the improvements. The order of individuals
+    // is kept in a heap, so a step does not sort or copy the population.
+    //
+    // The first call evaluates the whole population with calculate_fitness(), so the cache, batch
+    // and incremental functions apply to it. Offspring are evaluated by `func` only, on the thread
+    // pool if it is set. Every individual counts as a survivor, and fitness values of replaced
+    // individuals are updated in place, so save_state() and get_best_genotype() see the current ones.
+    void evolve_steady_state(fitness_function &func, const std::size_t count, const steady_state_options &options)
+    {
+        instrumentation::generation_scope scope(phases);
+        if (!is_steady_state)
+        {
+            instrumentation::phase_timer timer(phases.fitness_nanoseconds);
+            start_steady_state(func);
+            if (interrupted)
+            {
+                return;
+            }
+        }
+
+        const std::size_t step_size = std::max<std::size_t>(options.offspring_per_step, 1);
+        offspring.resize(2 * ((step_size + 1) / 2), model->create_genotype());
+        offspring_scores.resize(offspring.size());
+
+        for (std::size_t created = 0; created < count; created += step_size)
+        {
+            if (is_cancelled())
+            {
+                interrupted = true;
+                return;
+            }
+
+            const std::size_t step_count = std::min(step_size, count - created);
+            {
+                instrumentation::phase_timer timer(phases.reproduction_nanoseconds);
+                breed_offspring(step_count, options.tournament_size);
+            }
+            {
+                instrumentation::phase_timer timer(phases.fitness_nanoseconds);
+                evaluate_offspring(func, step_count);
+            }
+            {
+                instrumentation::phase_timer timer(phases.selection_nanoseconds);
+                for (std::size_t k = 0; k < step_count; ++k)
+                {
+                    replace(k, options);
+                }
+            }
+        }
+
+        if (is_summary_enabled)
+        {
+            summary_accumulator.reset();
+            for (const auto fitness : slot_fitness)
+            {
+                summary_accumulator.add(fitness);
+            }
+            summary = summary_accumulator.get();
+        }
     }
 
 
@@ -153,9 +444,142 @@ public:
         return *model;
     }
 
-    const Genotype &get_best_genotype() const
+    genotype_reference get_best_genotype() const
     {
-        return *fitness_values.front().genotype;
+        return generation[is_steady_state ? best_slot : fitness_values.front().index];
+    }
+
+    const Storage &get_storage() const
+    {
+        return generation;
+    }
+
+
+    // Copies up to `count` best survivors of the last selection into `elites` in the order
+    // of decreasing fitness. Elements of `elites` are reused.
+    void copy_elites(const std::size_t count, std::vector<Genotype> &elites)
+    {
+        ranked_survivors.assign(fitness_values.begin(), fitness_values.begin() + selected.size());
+        const std::size_t elites_count = std::min(count, ranked_survivors.size());
+        std::partial_sort(ranked_survivors.begin(), ranked_survivors.begin() + elites_count, ranked_survivors.end(),
+                          [](const genotype_fitness &a, const genotype_fitness &b) {
+                              return a.fitness > b.fitness;
+                          });
+
+        elites.resize(elites_count);
+        for (std::size_t i = 0; i < elites_count; ++i)
+        {
+            elites[i] = generation.as_representation(ranked_survivors[i].index, cache_key);
+        }
+    }
+
+
+    // Overwrites the last children of the generation with `migrants`, so survivors are kept.
+    // Migrants are evaluated along with the rest of the next generation.
+    void inject_migrants(const std::vector<Genotype> &migrants)
+    {
+        const std::size_t children_count = size() - std::min(size(), selected.size());
+        const std::size_t count = std::min(migrants.size(), children_count);
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            const std::size_t i = size() - 1 - k;
+            genotype_view<gene_value_type> target(generation[i]);
+            std::copy(migrants[k].begin(), migrants[k].end(), target.begin());
+
+            if (incremental_function)
+            {
+                lineage[i].fitness_is_known = false;
+                lineage[i].changes.mark_complete();
+            }
+        }
+    }
+
+
+    // Calls `func` for every random generator used by the evolution in a fixed order.
+    template <class Function>
+    void for_each_random_generator(Function func)
+    {
+        func(rg);
+        model->for_each_random_generator(func);
+        if (selection_engine)
+        {
+            func(selection_engine->get_random_generator());
+        }
+    }
+
+
+    // Writes the generation, fitness values of the last selection and states of generators.
+    // Fitness cache and incremental fitness states are not saved, so after loading
+    // genotypes are evaluated from scratch once.
+    void save_state(detail::binary_writer &writer)
+    {
+        const std::size_t length = model->size();
+        writer.write(static_cast<std::uint64_t>(generation.size()));
+        writer.write(static_cast<std::uint64_t>(length));
+        writer.write(static_cast<std::uint64_t>(selected.size()));
+        writer.write(best_achieved_fitness);
+        writer.write(overall_fitness);
+
+        for (std::size_t i = 0; i < generation.size(); ++i)
+        {
+            detail::write_genes<gene_value_type>(writer, generation.as_representation(i, cache_key), length);
+        }
+
+        for (std::size_t i = 0; i < selected.size(); ++i)
+        {
+            writer.write(fitness_values[i].fitness);
+        }
+
+        for_each_random_generator([&writer](random_generator &generator) {
+            writer.write(generator.get_engine().get_state());
+        });
+    }
+
+
+    // Restores the state written by save_state() with the same model and population size.
+    // Returns false if the data does not match them.
+    bool load_state(detail::binary_reader &reader)
+    {
+        std::uint64_t generation_size = 0;
+        std::uint64_t length = 0;
+        std::uint64_t selected_size = 0;
+        if (!reader.read(generation_size) || !reader.read(length) || !reader.read(selected_size) ||
+            generation_size != max_size || length != model->size() || selected_size > generation_size ||
+            !reader.read(best_achieved_fitness) || !reader.read(overall_fitness))
+        {
+            return false;
+        }
+
+        init();
+        for (std::size_t i = 0; i < generation.size(); ++i)
+        {
+            if (!detail::read_genes<gene_value_type>(reader, genotype_view<gene_value_type>(generation[i]), length))
+            {
+                return false;
+            }
+        }
+
+        selected.clear();
+        for (std::size_t i = 0; i < selected_size; ++i)
+        {
+            double fitness = 0;
+            if (!reader.read(fitness))
+            {
+                return false;
+            }
+
+            fitness_values[i] = genotype_fitness(fitness, i);
+            selected.push_back(fitness_values[i]);
+        }
+
+        bool is_read = true;
+        for_each_random_generator([&reader, &is_read](random_generator &generator) {
+            random_generator::engine_type::state state;
+            is_read = is_read && reader.read(state);
+            if (is_read) generator.get_engine().set_state(state);
+        });
+
+        return is_read;
     }
 
 
@@ -166,14 +590,368 @@ public:
         });
     }
 
+private:
+    void start_steady_state(fitness_function &func)
+    {
+        calculate_fitness(func);
+        if (interrupted)
+        {
+            return;
+        }
+
+        const std::size_t count = generation.size();
+        slot_fitness.resize(count);
+        heap.resize(count);
+        heap_positions.resize(count);
+        std::size_t best_index = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            slot_fitness[i] = fitness_values[i].fitness;
+            heap[i] = i;
+            heap_positions[i] = i;
+            if (slot_fitness[i] > slot_fitness[best_index]) best_index = i;
+        }
+
+        for (std::size_t i = count / 2; i-- > 0;)
+        {
+            sift_down(i);
+        }
+
+        fitness_sum = overall_fitness * count;
+        best_slot = best_index;
+        selected.assign(fitness_values.begin(), fitness_values.begin() + static_cast<std::ptrdiff_t>(count));
+        is_steady_state = true;
+    }
+
+    std::size_t tournament_winner(const std::size_t tournament_size)
+    {
+        const std::uniform_int_distribution<std::size_t> pick(0, generation.size() - 1);
+        std::size_t winner = rg.generate(pick);
+        for (std::size_t i = 1; i < tournament_size; ++i)
+        {
+            const std::size_t candidate = rg.generate(pick);
+            if (slot_fitness[candidate] > slot_fitness[winner]) winner = candidate;
+        }
+
+        return winner;
+    }
+
+    void breed_offspring(const std::size_t count, const std::size_t tournament_size)
+    {
+        using const_view = typename GenotypeModel::const_view;
+        using view = typename GenotypeModel::view;
+
+        for (std::size_t k = 0; k < count; k += 2)
+        {
+            const std::size_t first_parent = tournament_winner(tournament_size);
+            const std::size_t second_parent = tournament_winner(tournament_size);
+            model->crossover(const_view(generation[first_parent]), const_view(generation[second_parent]),
+                             view(offspring[k]), view(offspring[k + 1]));
+            model->mutate(view(offspring[k]));
+            if (k + 1 < count) model->mutate(view(offspring[k + 1]));
+            instrumentation::count(phases.crossovers);
+        }
+    }
+
+    void evaluate_offspring(fitness_function &func, const std::size_t count)
+    {
+        instrumentation::count(phases.fitness_evaluations, count);
+        const auto evaluate = [this, &func](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t k = begin; k < end; ++k)
+            {
+                offspring_scores[k] = func(offspring[k]);
+            }
+        };
+
+        if (pool != nullptr && pool->size() > 1 && count > 1)
+        {
+            pool->parallel_for(count, 1, evaluate);
+        }
+        else
+        {
+            evaluate(0, count, 0);
+        }
+    }
+
+    void replace(const std::size_t k, const steady_state_options &options)
+    {
+        std::size_t victim = heap.front();
+        if (options.replacement == steady_state_replacement::tournament)
+        {
+            const std::uniform_int_distribution<std::size_t> pick(0, generation.size() - 1);
+            victim = rg.generate(pick);
+            for (std::size_t i = 1; i < options.tournament_size; ++i)
+            {
+                const std::size_t candidate = rg.generate(pick);
+                if (slot_fitness[candidate] < slot_fitness[victim]) victim = candidate;
+            }
+        }
+
+        const double fitness = offspring_scores[k];
+        if (fitness < slot_fitness[victim])
+        {
+            return;
+        }
+
+        std::copy(offspring[k].begin(), offspring[k].end(), genotype_view<gene_value_type>(generation[victim]).begin());
+        fitness_sum += fitness - slot_fitness[victim];
+        overall_fitness = fitness_sum / generation.size();
+        slot_fitness[victim] = fitness;
+        fitness_values[victim] = genotype_fitness(fitness, victim);
+        selected[victim] = fitness_values[victim];
+        sift_down(heap_positions[victim]);
+
+        if (incremental_function)
+        {
+            lineage[victim].fitness_is_known = false;
+            lineage[victim].changes.mark_complete();
+        }
+
+        if (fitness >= slot_fitness[best_slot])
+        {
+            best_slot = victim;
+            best_achieved_fitness = std::max(best_achieved_fitness, fitness);
+        }
+    }
+
+    // The fitness of an individual only grows, so it can only move down the min-heap.
+    void sift_down(std::size_t position)
+    {
+        const std::size_t count = heap.size();
+        for (;;)
+        {
+            std::size_t smallest = position;
+            const std::size_t left = 2 * position + 1;
+            const std::size_t right = left + 1;
+            if (left < count && slot_fitness[heap[left]] < slot_fitness[heap[smallest]]) smallest = left;
+            if (right < count && slot_fitness[heap[right]] < slot_fitness[heap[smallest]]) smallest = right;
+            if (smallest == position)
+            {
+                return;
+            }
+
+            std::swap(heap[position], heap[smallest]);
+            heap_positions[heap[position]] = position;
+            heap_positions[heap[smallest]] = smallest;
+            position = smallest;
+        }
+    }
+
+    void apply_selection()
+    {
+        selected_indices.clear();
+        for (std::size_t i = 0; i < selected.size(); ++i)
+        {
+            selected_indices.push_back(selected[i].index);
+            fitness_values[i] = genotype_fitness(selected[i].fitness, i);
+        }
+
+        generation.select(selected_indices);
+
+        if (incremental_function)
+        {
+            // Survivors keep their fitness and states, which move along with them.
+            for (std::size_t i = 0; i < selected_indices.size(); ++i)
+            {
+                std::swap(next_states[i], states[selected_indices[i]]);
+                lineage[i].fitness_is_known = true;
+            }
+            states.swap(next_states);
+        }
+    }
+
+    struct genotype_lineage
+    {
+        bool fitness_is_known = false;
+        std::size_t parent = 0;
+        operators::change_set changes;
+    };
+
+    void reset_lineage()
+    {
+        for (auto &entry : lineage)
+        {
+            entry.fitness_is_known = false;
+            entry.changes.mark_complete();
+        }
+    }
+
+    void calculate_fitness_incrementally()
+    {
+        const auto evaluate = [this](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                auto &entry = lineage[i];
+                if (entry.fitness_is_known)
+                {
+                    continue;
+                }
+
+                if ((i - begin) % cancellation_check_interval() == 0 && is_cancelled())
+                {
+                    for (; i < end; ++i)
+                    {
+                        if (!lineage[i].fitness_is_known)
+                            fitness_values[i] = genotype_fitness(std::numeric_limits<double>::lowest(), i);
+                    }
+                    return;
+                }
+
+                double fitness;
+                if (entry.changes.is_complete())
+                {
+                    fitness = incremental_function->evaluate(generation[i], states[i]);
+                }
+                else
+                {
+                    entry.changes.normalize();
+                    states[i] = states[entry.parent];
+                    fitness = incremental_function->update(generation[i], generation[entry.parent],
+                                                           fitness_values[entry.parent].fitness,
+                                                           states[i], entry.changes);
+                }
+
+                fitness_values[i] = genotype_fitness(fitness, i);
+                entry.fitness_is_known = true;
+            }
+        };
+
+        if (instrumentation::is_enabled)
+        {
+            for (std::size_t i = 0; i < generation.size(); ++i)
+            {
+                instrumentation::count(phases.fitness_evaluations, lineage[i].fitness_is_known ? 0 : 1);
+            }
+        }
+
+        if (pool != nullptr && pool->size() > 1)
+        {
+            pool->parallel_for(generation.size(), fitness_chunk_size, evaluate);
+        }
+        else
+        {
+            evaluate(0, generation.size(), 0);
+        }
+
+        interrupted = is_cancelled();
+        summarize_fitness();
+        if (interrupted)
+        {
+            sort_fitness_values();
+        }
+    }
+
+    // Reduction is done in index order, so the sum does not depend on scheduling. Genotypes left
+    // unevaluated by cancellation are not counted.
+    void summarize_fitness()
+    {
+        double fitness_sum = 0;
+        std::size_t evaluated = 0;
+        best_achieved_fitness = 0;
+        if (is_summary_enabled)
+        {
+            summary_accumulator.reset();
+        }
+
+        for (std::size_t i = 0; i < generation.size(); ++i)
+        {
+            const double fitness = fitness_values[i].fitness;
+            if (interrupted && fitness == std::numeric_limits<double>::lowest())
+                continue;
+
+            fitness_sum += fitness;
+            ++evaluated;
+            if (fitness > best_achieved_fitness)
+                best_achieved_fitness = fitness;
+            if (is_summary_enabled)
+                summary_accumulator.add(fitness);
+        }
+
+        overall_fitness = evaluated > 0 ? fitness_sum / evaluated : 0;
+        if (is_summary_enabled)
+        {
+            summary = summary_accumulator.get();
+        }
+    }
+
+    static constexpr std::size_t cancellation_check_interval()
+    {
+        return 16;
+    }
+
+    bool is_cancelled() const
+    {
+        return cancellation != nullptr && cancellation->is_cancelled();
+    }
+
+    // Genotypes left after cancellation get the lowest fitness.
+    void evaluate_pending(fitness_function &func, const std::size_t begin, const std::size_t end)
+    {
+        const double lowest = std::numeric_limits<double>::lowest();
+        if (batch_function)
+        {
+            if (is_cancelled())
+            {
+                std::fill(pending_scores.begin() + begin, pending_scores.begin() + end, lowest);
+                return;
+            }
+
+            const genotype_batch<Storage> batch(generation, pending_indices.data() + begin, end - begin);
+            batch_function(batch, functions::fitness_scores(pending_scores.data() + begin, end - begin));
+            return;
+        }
+
+        for (std::size_t k = begin; k < end; ++k)
+        {
+            if ((k - begin) % cancellation_check_interval() == 0 && is_cancelled())
+            {
+                std::fill(pending_scores.begin() + k, pending_scores.begin() + end, lowest);
+                return;
+            }
+            pending_scores[k] = func(generation[pending_indices[k]]);
+        }
+    }
+
 private:
     std::shared_ptr<GenotypeModel> model;
     GenotypeConstructor constructor;
     std::size_t max_size;
-    std::vector<Genotype> generation;
+    Storage generation;
     std::vector<genotype_fitness> fitness_values;
+    std::vector<genotype_fitness> selected;
+    std::vector<std::size_t> selected_indices;
+    std::vector<genotype_fitness> ranked_survivors;
     double best_achieved_fitness;
     double overall_fitness;
+    thread_pool *pool;
+    std::size_t fitness_chunk_size;
+    std::unique_ptr<fitness_cache<Genotype>> cache;
+    Genotype cache_key;
+    std::vector<std::size_t> pending_indices;
+    std::vector<double> pending_scores;
+    batch_fitness_function batch_function;
+    std::shared_ptr<incremental_fitness_type> incremental_function;
+    double max_changes_ratio;
+    bool is_summary_enabled;
+    fitness_summary_accumulator summary_accumulator;
+    fitness_summary summary;
+    phase_statistics phases;
+    const cancellation_token *cancellation;
+    bool interrupted;
+    bool is_steady_state;
+    std::size_t best_slot;
+    std::vector<double> slot_fitness;
+    std::vector<std::size_t> heap; // min-heap of individuals by fitness
+    std::vector<std::size_t> heap_positions;
+    std::vector<Genotype> offspring;
+    std::vector<double> offspring_scores;
+    double fitness_sum;
+    std::vector<typename incremental_fitness_type::state_type> states;
+    std::vector<typename incremental_fitness_type::state_type> next_states;
+    std::vector<genotype_lineage> lineage;
+    operators::change_set spare_changes;
+    std::unique_ptr<operators::selection> selection_engine;
+    random_generator rg;
 };
 
 } // namespace ga
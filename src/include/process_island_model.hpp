@@ -0,0 +1,470 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "island_model.hpp"
+#include "detail/process_channel.hpp"
+#include "detail/serialization.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+namespace ga
+{
+namespace detail
+{
+
+inline volatile std::sig_atomic_t &worker_stop_flag()
+{
+    static volatile std::sig_atomic_t flag = 0;
+    return flag;
+}
+
+inline void request_worker_stop(int)
+{
+    worker_stop_flag() = 1;
+}
+
+} // namespace detail
+
+
+// Runs islands in forked worker processes, so a fitness function which crashes or leaks memory
+// takes down only its own island. Migrants and progress reports are encoded by write_genotypes
+// and passed through process channels. The calling process coordinates: it aggregates reports
+// into statistics, calls the loggers, and when the time limit passes or the fitness cap is
+// reached it asks workers to stop with SIGTERM and kills those which do not stop in time.
+//
+// Only POSIX systems are supported. Workers are forked from the calling process, so it should
+// not run other threads at that moment. Genes are copied as raw values of the model value type.
+template <class GenotypeModel, class Storage = vector_storage<GenotypeModel>>
+class process_island_model
+{
+public:
+    using genotype_representation = typename GenotypeModel::representation;
+    using population_type = population<GenotypeModel, Storage>;
+    using fitness_function_type = typename population_type::fitness_function;
+    using model_factory_type = std::function<std::shared_ptr<GenotypeModel>()>;
+    using loggers_type = std::vector<std::unique_ptr<logging::logger>>;
+
+public:
+    process_island_model(model_factory_type model_factory,
+                         fitness_function_type fitness_function,
+                         functions::rank_distribution rank_distribution_function):
+            model_factory(std::move(model_factory)),
+            fitness_function(std::move(fitness_function)),
+            rank_distribution_function(std::move(rank_distribution_function)),
+            transport(process_transport::shared_memory),
+            report_interval(std::chrono::milliseconds(10)),
+            shutdown_grace_period(std::chrono::milliseconds(1000)),
+            failed_workers_count(0)
+    {
+    }
+
+    // Shared memory is used unless sockets are requested or the mapping fails.
+    void set_transport(const process_transport value)
+    {
+        transport = value;
+    }
+
+    // How often the coordinator collects reports of workers.
+    void set_report_interval(const std::chrono::milliseconds value)
+    {
+        report_interval = value;
+    }
+
+    // How long stopped workers may take to send their last report before they are killed.
+    void set_shutdown_grace_period(const std::chrono::milliseconds value)
+    {
+        shutdown_grace_period = value;
+    }
+
+    // Returns the best genotype reported by the workers.
+    genotype_representation run(const parameters &params,
+                                const island_parameters &island_params,
+                                const loggers_type &loggers = {})
+    {
+        if (params.gather_generations_statistics)
+        {
+            stats.set_generations_history(params.generations_history_limit, params.generations_history_mode);
+        }
+
+        const std::size_t count = std::max<std::size_t>(island_params.islands_count == 0 ?
+                                                        std::thread::hardware_concurrency() :
+                                                        island_params.islands_count, 1);
+        connect(count, island_params);
+
+        workers = std::vector<worker>(count);
+        best_genotype.clear();
+        stats.set_best_achieved_fitness(0);
+        failed_workers_count = 0;
+        start_time = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const pid_t pid = fork();
+            if (pid == 0)
+            {
+                int status = 1;
+                try
+                {
+                    evolve_island(i, params, island_params);
+                    status = 0;
+                }
+                catch (...)
+                {
+                }
+                _exit(status);
+            }
+
+            workers[i].pid = pid;
+            workers[i].is_running = pid > 0;
+            if (pid < 0) ++failed_workers_count;
+        }
+
+        coordinate(params, loggers);
+        for (auto &logger_ptr : loggers)
+        {
+            logger_ptr->flush();
+        }
+
+        return best_genotype;
+    }
+
+    const statistics &get_statistics() const
+    {
+        return stats;
+    }
+
+    // Workers which crashed, exited with an error or had to be killed during the last run.
+    std::size_t get_failed_workers_count() const
+    {
+        return failed_workers_count;
+    }
+
+private:
+    using message_type = std::vector<unsigned char>;
+
+    struct worker
+    {
+        pid_t pid = -1;
+        bool is_running = false;
+        double best_fitness = 0;
+        std::uint64_t generations = 0;
+        std::uint64_t migrants_sent = 0;
+        std::uint64_t migrants_dropped = 0;
+    };
+
+    // Progress report of a worker: counters followed by its best genotype.
+    struct report_header
+    {
+        double best_fitness;
+        std::uint64_t generations;
+        std::uint64_t migrants_sent;
+        std::uint64_t migrants_dropped;
+    };
+
+    void connect(const std::size_t count, const island_parameters &island_params)
+    {
+        const std::size_t genes_size = model_factory()->size() * sizeof(typename GenotypeModel::value_type);
+        const std::size_t migration_size = 64 + island_params.migrants_count * genes_size;
+        const std::size_t migration_capacity = std::max<std::size_t>(island_params.mailbox_capacity, 1) * migration_size;
+        const std::size_t report_capacity = 4 * (64 + sizeof(report_header) + genes_size);
+
+        channels.clear();
+        routes.assign(count, {});
+        report_channels.clear();
+
+        for (std::size_t from = 0; from < count; ++from)
+        {
+            report_channels.push_back(std::make_unique<detail::process_channel>(report_capacity, transport));
+            for (std::size_t to = 0; to < count; ++to)
+            {
+                const bool is_connected = island_params.topology == migration_topology::ring ?
+                                          count > 1 && to == (from + 1) % count :
+                                          to != from;
+                if (is_connected)
+                {
+                    channels.push_back(std::make_unique<detail::process_channel>(migration_capacity, transport));
+                    routes[from].emplace_back(to, channels.back().get());
+                }
+            }
+        }
+    }
+
+    // Runs in the worker process.
+    void evolve_island(const std::size_t index, const parameters &params, const island_parameters &island_params)
+    {
+        detail::worker_stop_flag() = 0;
+        struct sigaction action{};
+        action.sa_handler = detail::request_worker_stop;
+        sigaction(SIGTERM, &action, nullptr);
+
+        population_type p(model_factory(), params.population_size);
+        p.set_selection(create_selection(params, rank_distribution_function));
+        random_generator rg;
+        if (params.random_seed != 0)
+        {
+            const std::uint64_t island_seed = random_generator::substream(params.random_seed, index);
+            p.seed(island_seed);
+            rg.seed(island_seed, random_generator::substream(island_seed, 6));
+        }
+        p.init();
+        p.enable_fitness_cache(params.fitness_cache_size, params.fitness_cache_eviction);
+
+        std::vector<detail::process_channel *> outgoing;
+        for (const auto &route : routes[index])
+        {
+            outgoing.push_back(route.second);
+        }
+
+        std::vector<detail::process_channel *> incoming;
+        for (std::size_t from = 0; from < routes.size(); ++from)
+        {
+            for (const auto &route : routes[from])
+            {
+                if (route.first == index) incoming.push_back(route.second);
+            }
+        }
+
+        auto &reports = *report_channels[index];
+        std::vector<genotype_representation> genotypes;
+        message_type message;
+        report_header report{0, 0, 0, 0};
+        bool is_reported = true;
+
+        std::chrono::milliseconds time_passed(0);
+        while (detail::worker_stop_flag() == 0 &&
+               params.generations_limit > report.generations &&
+               params.desired_fitness_cap > report.best_fitness &&
+               params.time_limit > time_passed)
+        {
+            p.evolve(fitness_function, rank_distribution_function, params.ranking_groups_number);
+            report.best_fitness = p.get_best_achieved_fitness();
+            ++report.generations;
+
+            if (island_params.migration_interval > 0 && report.generations % island_params.migration_interval == 0 &&
+                !outgoing.empty())
+            {
+                p.copy_elites(island_params.migrants_count, genotypes);
+                encode(message, nullptr, genotypes);
+
+                if (island_params.topology == migration_topology::random)
+                {
+                    count_migration(report, genotypes.size(), rg.pick_item(outgoing)->try_send(message));
+                }
+                else
+                {
+                    for (auto *channel : outgoing)
+                    {
+                        count_migration(report, genotypes.size(), channel->try_send(message));
+                    }
+                }
+            }
+
+            for (auto *channel : incoming)
+            {
+                while (channel->try_receive(message))
+                {
+                    detail::binary_reader reader(message.data(), message.size());
+                    if (detail::read_genotypes(reader, genotypes))
+                    {
+                        p.inject_migrants(genotypes);
+                    }
+                }
+            }
+
+            p.copy_elites(1, genotypes);
+            encode(message, &report, genotypes);
+            is_reported = reports.try_send(message);
+
+            time_passed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start_time);
+        }
+
+        // The last report must reach the coordinator, which keeps reading until the worker exits.
+        while (!is_reported)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            is_reported = reports.try_send(message);
+        }
+    }
+
+    static void count_migration(report_header &report, const std::size_t migrants, const bool is_sent)
+    {
+        (is_sent ? report.migrants_sent : report.migrants_dropped) += migrants;
+    }
+
+    static void encode(message_type &message, const report_header *report,
+                       const std::vector<genotype_representation> &genotypes)
+    {
+        message.clear();
+        detail::binary_writer writer(message);
+        if (report != nullptr)
+        {
+            writer.write(*report);
+        }
+        detail::write_genotypes(writer, genotypes);
+    }
+
+    // Runs in the calling process until all workers exit.
+    void coordinate(const parameters &params, const loggers_type &loggers)
+    {
+        bool is_stopping = false;
+        auto stop_time = std::chrono::steady_clock::now();
+        message_type message;
+        std::vector<genotype_representation> genotypes;
+
+        for (;;)
+        {
+            bool has_running = false;
+            for (std::size_t i = 0; i < workers.size(); ++i)
+            {
+                auto &w = workers[i];
+                if (!w.is_running)
+                {
+                    continue;
+                }
+
+                int status = 0;
+                pid_t result = 0;
+                do
+                {
+                    result = waitpid(w.pid, &status, WNOHANG);
+                }
+                while (result == -1 && errno == EINTR);
+
+                if (result == w.pid)
+                {
+                    w.is_running = false;
+                    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) ++failed_workers_count;
+                }
+                else if (result == -1)
+                {
+                    // The worker was reaped elsewhere, e.g. SIGCHLD is ignored, so its exit status is unknown.
+                    w.is_running = false;
+                    ++failed_workers_count;
+                }
+
+                // Reports sent right before exit are still in the channel.
+                while (report_channels[i]->try_receive(message))
+                {
+                    read_report(w, message, genotypes);
+                }
+
+                has_running = has_running || w.is_running;
+            }
+
+            update_statistics(loggers);
+            if (!has_running)
+            {
+                break;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (!is_stopping && (now - start_time >= params.time_limit ||
+                                 stats.get_best_achieved_fitness() >= params.desired_fitness_cap))
+            {
+                is_stopping = true;
+                stop_time = now;
+                signal_running(SIGTERM);
+            }
+            else if (is_stopping && now - stop_time >= shutdown_grace_period)
+            {
+                signal_running(SIGKILL);
+            }
+
+            std::this_thread::sleep_for(report_interval);
+        }
+    }
+
+    void read_report(worker &w, const message_type &message, std::vector<genotype_representation> &genotypes)
+    {
+        detail::binary_reader reader(message.data(), message.size());
+        report_header report;
+        if (!reader.read(report) || !detail::read_genotypes(reader, genotypes))
+        {
+            return;
+        }
+
+        w.generations = report.generations;
+        w.migrants_sent = report.migrants_sent;
+        w.migrants_dropped = report.migrants_dropped;
+        w.best_fitness = report.best_fitness;
+
+        if (!genotypes.empty() && (best_genotype.empty() || report.best_fitness > stats.get_best_achieved_fitness()))
+        {
+            best_genotype = genotypes.front();
+            stats.set_best_achieved_fitness(report.best_fitness);
+        }
+    }
+
+    void signal_running(const int signal_number)
+    {
+        for (const auto &w : workers)
+        {
+            if (w.is_running) kill(w.pid, signal_number);
+        }
+    }
+
+    // Generations are counted by the most advanced worker.
+    void update_statistics(const loggers_type &loggers)
+    {
+        std::uint64_t generations = 0;
+        std::uint64_t sent = 0;
+        std::uint64_t dropped = 0;
+        for (const auto &w : workers)
+        {
+            generations = std::max(generations, w.generations);
+            sent += w.migrants_sent;
+            dropped += w.migrants_dropped;
+        }
+
+        const auto time_passed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start_time);
+
+        stats.set_milliseconds_passed(time_passed.count());
+        stats.set_migration_counters(sent, dropped);
+        stats.add_generation_stats_entry(generations, stats.get_best_achieved_fitness());
+
+        for (auto &logger_ptr : loggers)
+        {
+            auto &logger = *logger_ptr;
+            logger(stats);
+        }
+    }
+
+private:
+    model_factory_type model_factory;
+    fitness_function_type fitness_function;
+    functions::rank_distribution rank_distribution_function;
+    process_transport transport;
+    std::chrono::milliseconds report_interval;
+    std::chrono::milliseconds shutdown_grace_period;
+    std::vector<std::unique_ptr<detail::process_channel>> channels;
+    std::vector<std::vector<std::pair<std::size_t, detail::process_channel *>>> routes;
+    std::vector<std::unique_ptr<detail::process_channel>> report_channels;
+    std::vector<worker> workers;
+    genotype_representation best_genotype;
+    std::size_t failed_workers_count;
+    std::chrono::steady_clock::time_point start_time;
+    statistics stats;
+};
+
+} // namespace ga
@@ -1,19 +1,37 @@
 #pragma once
 
+#include "philox_engine.hpp"
+
 #include <cstddef>
+#include <cstdint>
 #include <random>
 #include <iterator>
+#include <atomic>
 
 
 namespace ga
 {
 
+// Generates random values from a stream of philox_engine. Generators created with a seed are
+// reproducible, other ones share a process-wide seed taken from std::random_device once and
+// get unique stream numbers, so constructing a generator does not involve system calls.
 class random_generator
 {
 public:
-    random_generator()
+    using engine_type = philox_engine;
+
+public:
+    random_generator(): generator(process_seed(), next_stream())
+    {
+    }
+
+    random_generator(const std::uint64_t seed_value, const std::uint64_t stream): generator(seed_value, stream)
+    {
+    }
+
+    void seed(const std::uint64_t seed_value, const std::uint64_t stream)
     {
-        generator.seed(random_device());
+        generator.seed(seed_value, stream);
     }
 
     template <class Distribution>
@@ -37,33 +55,77 @@ public:
         return *it;
     }
 
+    engine_type &get_engine()
+    {
+        return generator;
+    }
+
+    const engine_type &get_engine() const
+    {
+        return generator;
+    }
+
+    // Stream number of the sub-stream `index` of the stream `stream`. Mixing keeps
+    // sub-streams of neighbouring streams apart.
+    static std::uint64_t substream(const std::uint64_t stream, const std::uint64_t index)
+    {
+        std::uint64_t x = stream * 0x9E3779B97F4A7C15ull + index;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
 private:
-    std::random_device random_device;
-    std::minstd_rand generator;
+    static std::uint64_t process_seed()
+    {
+        static const std::uint64_t value = [] {
+            std::random_device device;
+            return (static_cast<std::uint64_t>(device()) << 32) | device();
+        }();
+
+        return value;
+    }
+
+    static std::uint64_t next_stream()
+    {
+        static std::atomic<std::uint64_t> counter{0};
+        return substream(~0ull, counter++);
+    }
+
+private:
+    engine_type generator;
 };
 
 
 template <>
-int random_generator::generate_with_uniform_distribution<int>(const int &min, const int &max)
+inline int random_generator::generate_with_uniform_distribution<int>(const int &min, const int &max)
 {
     std::uniform_int_distribution<int> d(min, max);
     return generate(d);
 }
 
 template <>
-short random_generator::generate_with_uniform_distribution<short>(const short &min, const short &max)
+inline short random_generator::generate_with_uniform_distribution<short>(const short &min, const short &max)
 {
     std::uniform_int_distribution<short> d(min, max);
     return generate(d);
 }
 
 template <>
-double random_generator::generate_with_uniform_distribution<double>(const double &min, const double &max)
+inline double random_generator::generate_with_uniform_distribution<double>(const double &min, const double &max)
 {
     std::uniform_real_distribution<double> d(min, max);
     return generate(d);
 }
 
+template <>
+inline std::uint64_t random_generator::generate_with_uniform_distribution<std::uint64_t>(const std::uint64_t &min,
+                                                                                         const std::uint64_t &max)
+{
+    std::uniform_int_distribution<std::uint64_t> d(min, max);
+    return generate(d);
+}
+
 
 template <class T>
 struct select_uniform_distribution_type
@@ -89,5 +151,11 @@ struct select_uniform_distribution_type<double>
     using type = std::uniform_real_distribution<double>;
 };
 
+template <>
+struct select_uniform_distribution_type<std::uint64_t>
+{
+    using type = std::uniform_int_distribution<std::uint64_t>;
+};
+
 
 }
@@ -0,0 +1,269 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "ga.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace ga
+{
+
+// Alternative to `algorithm` where the fitness function and operators are template parameters.
+// Operators are kept by value and called through their concrete types, so their final overrides
+// are bound at compile time and the whole reproduce loop can be inlined.
+//
+// Crossover has to provide apply(const_view, const_view, view, view), every mutation
+// apply(const GenotypeModel &, view), and selection select(candidates, selected) as the
+// engines of operators/selection.hpp do.
+template <class GenotypeModel, class FitnessFunction, class Crossover, class Selection, class... Mutations>
+class static_algorithm
+{
+public:
+    using genotype_representation = typename GenotypeModel::representation;
+    using gene_value_type = typename GenotypeModel::value_type;
+    using view = genotype_view<gene_value_type>;
+    using const_view = genotype_view<const gene_value_type>;
+    using loggers_type = std::vector<std::unique_ptr<logging::logger>>;
+
+public:
+    static_algorithm(const std::shared_ptr<GenotypeModel> &model,
+                     FitnessFunction fitness_function,
+                     Crossover crossover,
+                     Selection selection,
+                     Mutations... mutations):
+            model(model),
+            fitness_function(std::move(fitness_function)),
+            crossover(std::move(crossover)),
+            selection(std::move(selection)),
+            mutations(std::move(mutations)...),
+            count(0),
+            best_achieved_fitness(0),
+            is_summary_enabled(false)
+    {
+    }
+
+    // Selection parameters of `params` are ignored, the selection engine is given by the type.
+    // Returns the best genotype of the last generation.
+    genotype_representation run(const parameters &params, const loggers_type &loggers = {})
+    {
+        if (params.gather_generations_statistics)
+        {
+            stats.set_generations_history(params.generations_history_limit, params.generations_history_mode);
+        }
+        is_summary_enabled = params.gather_generations_statistics;
+
+        const auto _model = model.lock();
+        genotype_constructor<GenotypeModel> constructor(_model);
+        if (params.random_seed != 0)
+        {
+            seed(params.random_seed);
+            constructor.seed(params.random_seed);
+        }
+
+        init(*_model, constructor, params.population_size);
+
+        const auto start_time = std::chrono::steady_clock::now();
+        std::chrono::milliseconds time_passed(0);
+        std::size_t num_of_generations_passed = 0;
+        best_achieved_fitness = 0.0;
+
+        while (params.generations_limit > num_of_generations_passed &&
+               params.desired_fitness_cap > best_achieved_fitness &&
+               params.time_limit > time_passed)
+        {
+            calculate_fitness();
+            select();
+            reproduce(*_model);
+
+            const auto now = std::chrono::steady_clock::now();
+            time_passed = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time);
+            ++num_of_generations_passed;
+
+            stats.set_best_achieved_fitness(best_achieved_fitness);
+            stats.set_milliseconds_passed(time_passed.count());
+            stats.add_generation_stats_entry(num_of_generations_passed, best_achieved_fitness,
+                                             is_summary_enabled ? summary.get() : fitness_summary());
+
+            for (auto &logger_ptr : loggers)
+            {
+                auto &logger = *logger_ptr;
+                logger(stats);
+            }
+        }
+
+        return best_genotype;
+    }
+
+    const statistics &get_statistics() const
+    {
+        return stats;
+    }
+
+private:
+    // Uses the same streams as population::seed.
+    void seed(const std::uint64_t seed_value)
+    {
+        rg.seed(seed_value, random_generator::substream(seed_value, 3));
+        crossover.seed(seed_value, random_generator::substream(seed_value, 2));
+        selection.seed(seed_value, random_generator::substream(seed_value, 4));
+        seed_mutations(seed_value, std::integral_constant<std::size_t, 0>());
+    }
+
+    template <std::size_t I>
+    void seed_mutations(const std::uint64_t seed_value, std::integral_constant<std::size_t, I>)
+    {
+        std::get<I>(mutations).seed(seed_value, random_generator::substream(seed_value, 16 + I));
+        seed_mutations(seed_value, std::integral_constant<std::size_t, I + 1>());
+    }
+
+    void seed_mutations(const std::uint64_t, std::integral_constant<std::size_t, sizeof...(Mutations)>)
+    {
+    }
+
+    void init(const GenotypeModel &m, const genotype_constructor<GenotypeModel> &constructor,
+              const std::size_t population_size)
+    {
+        const genotype_representation blank = m.create_genotype();
+        current.assign(population_size, blank);
+        next.assign(population_size, blank);
+        spare_child = blank;
+        fitness_values.reserve(population_size);
+        selected.reserve(population_size);
+
+        count = population_size;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            constructor.construct_random(view(current[i]), i);
+        }
+    }
+
+    void calculate_fitness()
+    {
+        fitness_values.clear();
+        summary.reset();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            fitness_values.emplace_back(fitness_function(static_cast<const genotype_representation &>(current[i])), i);
+            if (is_summary_enabled)
+                summary.add(fitness_values.back().fitness);
+        }
+    }
+
+    // Survivors are swapped into the other buffer, so turnover does not allocate.
+    void select()
+    {
+        selection.select(fitness_values, selected);
+
+        best_achieved_fitness = selected.front().fitness;
+        best_genotype = current[selected.front().index];
+
+        for (std::size_t i = 0; i < selected.size(); ++i)
+        {
+            std::swap(next[i], current[selected[i].index]);
+        }
+
+        current.swap(next);
+        count = selected.size();
+    }
+
+    void reproduce(const GenotypeModel &m)
+    {
+        const std::size_t last_generation_member_index = count - 1;
+        const std::size_t amount = current.size() - count;
+
+        std::size_t first_parent = 0;
+        for (std::size_t k = 0; k < amount; k += 2)
+        {
+            // A single survivor is crossed with itself.
+            const std::size_t second_parent = last_generation_member_index == 0 ? 0 : rg.generate(
+                    std::uniform_int_distribution<std::size_t>(first_parent + 1, last_generation_member_index));
+            const bool both = k + 1 < amount;
+
+            view first(current[count]);
+            view second(both ? current[count + 1] : spare_child);
+            crossover.apply(const_view(current[first_parent]), const_view(current[second_parent]), first, second);
+            mutate(m, first);
+            if (both) mutate(m, second);
+
+            count += both ? 2 : 1;
+            if (++first_parent >= last_generation_member_index) first_parent = 0;
+        }
+    }
+
+    // Applies one mutation picked at random, like genotype_model::mutate.
+    void mutate(const GenotypeModel &m, view g)
+    {
+        if (sizeof...(Mutations) == 0)
+        {
+            return;
+        }
+
+        const std::size_t index = rg.generate(
+                std::uniform_int_distribution<std::size_t>(0, sizeof...(Mutations) - 1));
+        mutate(m, g, index, std::integral_constant<std::size_t, 0>());
+    }
+
+    template <std::size_t I>
+    void mutate(const GenotypeModel &m, view g, const std::size_t index, std::integral_constant<std::size_t, I>)
+    {
+        if (index == I)
+        {
+            std::get<I>(mutations).apply(m, g);
+        }
+        else
+        {
+            mutate(m, g, index, std::integral_constant<std::size_t, I + 1>());
+        }
+    }
+
+    void mutate(const GenotypeModel &, view, const std::size_t,
+                std::integral_constant<std::size_t, sizeof...(Mutations)>)
+    {
+    }
+
+private:
+    std::weak_ptr<GenotypeModel> model;
+    FitnessFunction fitness_function;
+    Crossover crossover;
+    Selection selection;
+    std::tuple<Mutations...> mutations;
+
+    std::vector<genotype_representation> current;
+    std::vector<genotype_representation> next;
+    genotype_representation spare_child;
+    genotype_representation best_genotype;
+    std::size_t count;
+    std::vector<genotype_fitness> fitness_values;
+    std::vector<genotype_fitness> selected;
+    double best_achieved_fitness;
+    bool is_summary_enabled;
+    fitness_summary_accumulator summary;
+    random_generator rg;
+    statistics stats;
+};
+
+
+template <class GenotypeModel, class FitnessFunction, class Crossover, class Selection, class... Mutations>
+auto make_static_algorithm(const std::shared_ptr<GenotypeModel> &model,
+                           FitnessFunction fitness_function,
+                           Crossover crossover,
+                           Selection selection,
+                           Mutations... mutations)
+{
+    return static_algorithm<GenotypeModel, FitnessFunction, Crossover, Selection, Mutations...>(
+            model, std::move(fitness_function), std::move(crossover), std::move(selection), std::move(mutations)...);
+}
+
+} // namespace ga
@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include "fitness_summary.hpp"
+#include "instrumentation.hpp"
+
+#include <algorithm>
 #include <cstddef>
 #include <string>
 #include <sstream>
@@ -15,14 +19,24 @@
 namespace ga
 {
 
+// How records of generations are dropped once their number reaches the history limit.
+enum class history_mode
+{
+    ring, // only the last records are kept
+    downsampling // every second record is dropped and the sampling step is doubled
+};
+
+
 class statistics
 {
 public:
     struct generation_record
     {
-        generation_record(const size_t generation_index, const double best_achieved_fitness) :
+        generation_record(const size_t generation_index, const double best_achieved_fitness,
+                          const fitness_summary &summary = fitness_summary()) :
                 generation_index(generation_index),
-                best_achieved_fitness(best_achieved_fitness)
+                best_achieved_fitness(best_achieved_fitness),
+                summary(summary)
         {
         }
 
@@ -32,13 +46,24 @@ public:
 
         std::size_t generation_index;
         double best_achieved_fitness;
+        fitness_summary summary; // empty if the algorithm does not gather it
+        phase_statistics phases;
     };
 
 public:
     statistics():
             best_achieved_fitness(0),
             milliseconds_passed(0),
-            gather_generations_statistics(false)
+            gather_generations_statistics(false),
+            history_limit(0),
+            history(history_mode::ring),
+            history_start(0),
+            sampling_step(1),
+            records_count(0),
+            fitness_cache_hits(0),
+            fitness_cache_misses(0),
+            migrants_sent(0),
+            migrants_dropped(0)
     {
     }
 
@@ -47,20 +72,49 @@ public:
         if (size > 0)
         {
             gather_generations_statistics = true;
-            reserve_generation_stats_space(size);
+            generations_stats.reserve(size);
         }
     }
 
-    void add_generation_stats_entry(const std::size_t index, const double fitness)
+    // Keeps at most `limit` records of generations, so memory does not grow with the number
+    // of generations. 0 - all records are kept.
+    void set_generations_history(const std::size_t limit, const history_mode mode)
+    {
+        gather_generations_statistics = true;
+        history_limit = limit;
+        history = mode;
+        history_start = 0;
+        sampling_step = 1;
+        records_count = 0;
+        generations_stats.clear();
+        generations_stats.reserve(limit > 0 ? limit : 1024);
+    }
+
+    void add_generation_stats_entry(const std::size_t index, const double fitness,
+                                    const fitness_summary &summary = fitness_summary())
     {
-        last_generation_stats = generation_record{index, fitness};
+        last_generation_stats = generation_record{index, fitness, summary};
+        last_generation_stats.phases = generation_phases;
 
         if (gather_generations_statistics)
         {
-            generations_stats.push_back(last_generation_stats);
+            add_to_history(last_generation_stats);
         }
     }
 
+    void reset_phase_statistics()
+    {
+        generation_phases = phase_statistics();
+        total_phases = phase_statistics();
+    }
+
+    // Phases of the generation recorded next. They are summed up over the run as well.
+    void set_generation_phases(const phase_statistics &phases)
+    {
+        generation_phases = phases;
+        total_phases += phases;
+    }
+
     void set_best_achieved_fitness(const double value)
     {
         best_achieved_fitness = value;
@@ -71,6 +125,18 @@ public:
         milliseconds_passed = value;
     }
 
+    void set_fitness_cache_counters(const std::size_t hits, const std::size_t misses)
+    {
+        fitness_cache_hits = hits;
+        fitness_cache_misses = misses;
+    }
+
+    void set_migration_counters(const std::size_t sent, const std::size_t dropped)
+    {
+        migrants_sent = sent;
+        migrants_dropped = dropped;
+    }
+
     double get_best_achieved_fitness() const
     {
         return best_achieved_fitness;
@@ -81,17 +147,107 @@ public:
         return milliseconds_passed;
     }
 
+    std::size_t get_fitness_cache_hits() const
+    {
+        return fitness_cache_hits;
+    }
+
+    std::size_t get_fitness_cache_misses() const
+    {
+        return fitness_cache_misses;
+    }
+
+    std::size_t get_migrants_sent() const
+    {
+        return migrants_sent;
+    }
+
+    // Migrants which did not fit into full mailboxes.
+    std::size_t get_migrants_dropped() const
+    {
+        return migrants_dropped;
+    }
+
     const generation_record &get_last_generation_stats() const
     {
         return last_generation_stats;
     }
 
+    const phase_statistics &get_total_phase_statistics() const
+    {
+        return total_phases;
+    }
+
+    // Gathered records in the order of generations.
+    std::vector<generation_record> get_generations_stats() const
+    {
+        std::vector<generation_record> result(generations_stats.begin() + history_start, generations_stats.end());
+        result.insert(result.end(), generations_stats.begin(), generations_stats.begin() + history_start);
+        return result;
+    }
+
+    // Number of generations between kept records in the downsampling mode.
+    std::size_t get_sampling_step() const
+    {
+        return sampling_step;
+    }
+
+private:
+    void add_to_history(const generation_record &record)
+    {
+        if (history_limit == 0 || generations_stats.size() < history_limit)
+        {
+            if (records_count++ % sampling_step == 0)
+            {
+                generations_stats.push_back(record);
+            }
+            return;
+        }
+
+        if (history == history_mode::ring)
+        {
+            generations_stats[history_start] = record;
+            history_start = (history_start + 1) % history_limit;
+            return;
+        }
+
+        // Records are always taken at multiples of the step, so each compaction keeps
+        // the records at multiples of the doubled one.
+        if (records_count % sampling_step == 0)
+        {
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < generations_stats.size(); i += 2)
+            {
+                generations_stats[kept++] = generations_stats[i];
+            }
+            generations_stats.resize(kept);
+            sampling_step *= 2;
+
+            if (records_count % sampling_step == 0)
+            {
+                generations_stats.push_back(record);
+            }
+        }
+        ++records_count;
+    }
+
 private:
     bool gather_generations_statistics;
     double best_achieved_fitness;
     long long milliseconds_passed;
     generation_record last_generation_stats;
     std::vector<generation_record> generations_stats;
+    std::size_t history_limit;
+    history_mode history;
+    std::size_t history_start; // index of the oldest record in the ring
+    std::size_t sampling_step;
+    std::size_t records_count;
+    phase_statistics generation_phases;
+    phase_statistics total_phases;
+    std::size_t fitness_cache_hits;
+    std::size_t fitness_cache_misses;
+    std::size_t migrants_sent;
+    std::size_t migrants_dropped;
 };
 
 } // namespace ga
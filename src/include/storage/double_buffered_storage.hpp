@@ -0,0 +1,118 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "../genotype_constructor.hpp"
+#include "../genotype_view.hpp"
+#include "../functions.hpp"
+#include "../operators/change_set.hpp"
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <utility>
+
+
+namespace ga
+{
+
+// Keeps genotypes as separate objects of the model representation in two pre-sized
+// generation buffers which swap their roles on every selection. Survivors are swapped
+// into the slots of the other buffer and children are written into the recycled slots
+// by the in-place operators, so after the first generation turnover does not allocate.
+template <class GenotypeModel>
+class double_buffered_storage
+{
+public:
+    using genotype = typename GenotypeModel::representation;
+    using gene_value_type = typename GenotypeModel::value_type;
+    using reference = genotype &;
+    using const_reference = const genotype &;
+    using fitness_function = functions::fitness<genotype>;
+
+public:
+    double_buffered_storage(const std::shared_ptr<GenotypeModel> &model, const std::size_t max_size):
+            current(max_size, model->create_genotype()),
+            next(max_size, model->create_genotype()),
+            spare_child(model->create_genotype()),
+            count(0)
+    {
+    }
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+    reference operator[](const std::size_t index)
+    {
+        return current[index];
+    }
+
+    const_reference operator[](const std::size_t index) const
+    {
+        return current[index];
+    }
+
+    const genotype &as_representation(const std::size_t index, genotype & /*buffer*/) const
+    {
+        return current[index];
+    }
+
+    void init(const genotype_constructor<GenotypeModel> &constructor, const std::size_t genotypes_count)
+    {
+        count = std::min(genotypes_count, current.size());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            constructor.construct_random(genotype_view<gene_value_type>(current[i]), i);
+        }
+    }
+
+    void select(const std::vector<std::size_t> &indices)
+    {
+        // Selected indices are unique, so every genotype is moved to the other buffer at most once.
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            std::swap(next[i], current[indices[i]]);
+        }
+
+        current.swap(next);
+        count = indices.size();
+    }
+
+    void add_children(GenotypeModel &model, const std::size_t first_parent, const std::size_t second_parent,
+                      const bool both,
+                      operators::change_set *first_changes = nullptr,
+                      operators::change_set *second_changes = nullptr)
+    {
+        genotype_view<gene_value_type> first(current[count]);
+        genotype_view<gene_value_type> second(both ? current[count + 1] : spare_child);
+
+        if (first_changes != nullptr)
+        {
+            model.crossover(current[first_parent], current[second_parent], first, second,
+                            *first_changes, *second_changes);
+            model.mutate(first, *first_changes);
+            if (both) model.mutate(second, *second_changes);
+        }
+        else
+        {
+            model.crossover(current[first_parent], current[second_parent], first, second);
+            model.mutate(first);
+            if (both) model.mutate(second);
+        }
+
+        count += both ? 2 : 1;
+    }
+
+private:
+    std::vector<genotype> current;
+    std::vector<genotype> next;
+    genotype spare_child;
+    std::size_t count;
+};
+
+} // namespace ga
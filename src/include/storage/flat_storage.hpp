@@ -0,0 +1,125 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "genome_matrix.hpp"
+#include "../detail/detail.hpp"
+#include "../genotype_constructor.hpp"
+#include "../genotype_view.hpp"
+#include "../functions.hpp"
+#include "../operators/change_set.hpp"
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+
+namespace ga
+{
+
+// Keeps genes of the whole generation in one contiguous buffer. Genotypes are
+// exposed as views to fitness functions and operators. Selection copies survivors
+// into the second buffer of the same size, so turnover of generations does not allocate.
+template <class GenotypeModel, genome_layout Layout = genome_layout::genotype_major>
+class flat_storage
+{
+public:
+    using genotype = typename GenotypeModel::representation;
+    using gene_value_type = typename GenotypeModel::value_type;
+    using reference = genotype_view<gene_value_type>;
+    using const_reference = genotype_view<const gene_value_type>;
+    using fitness_function = functions::view_fitness<gene_value_type>;
+
+public:
+    flat_storage(const std::shared_ptr<GenotypeModel> &model, const std::size_t max_size):
+            current(max_size, model->size(), Layout),
+            next(max_size, model->size(), Layout),
+            spare_child(model->create_genotype()),
+            count(0)
+    {
+    }
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+    reference operator[](const std::size_t index)
+    {
+        return current.genotype(index);
+    }
+
+    const_reference operator[](const std::size_t index) const
+    {
+        return current.genotype(index);
+    }
+
+    const genotype &as_representation(const std::size_t index, genotype &buffer) const
+    {
+        const auto genes = current.genotype(index);
+        detail::assign_genotype(buffer, genes.begin(), genes.end());
+        return buffer;
+    }
+
+    const genome_matrix<gene_value_type> &get_genome_matrix() const
+    {
+        return current;
+    }
+
+    void init(const genotype_constructor<GenotypeModel> &constructor, const std::size_t genotypes_count)
+    {
+        count = std::min(genotypes_count, current.size());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            constructor.construct_random(current.genotype(i), i);
+        }
+    }
+
+    void select(const std::vector<std::size_t> &indices)
+    {
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            const auto from = current.genotype(indices[i]);
+            std::copy(from.begin(), from.end(), next.genotype(i).begin());
+        }
+
+        current.swap(next);
+        count = indices.size();
+    }
+
+    void add_children(GenotypeModel &model, const std::size_t first_parent, const std::size_t second_parent,
+                      const bool both,
+                      operators::change_set *first_changes = nullptr,
+                      operators::change_set *second_changes = nullptr)
+    {
+        auto first = current.genotype(count);
+        auto second = both ? current.genotype(count + 1) : reference(spare_child);
+
+        if (first_changes != nullptr)
+        {
+            model.crossover(current.genotype(first_parent), current.genotype(second_parent), first, second, *first_changes, *second_changes);
+            model.mutate(first, *first_changes);
+            if (both) model.mutate(second, *second_changes);
+        }
+        else
+        {
+            model.crossover(current.genotype(first_parent), current.genotype(second_parent), first, second);
+            model.mutate(first);
+            if (both) model.mutate(second);
+        }
+
+        count += both ? 2 : 1;
+    }
+
+private:
+    genome_matrix<gene_value_type> current;
+    genome_matrix<gene_value_type> next;
+    genotype spare_child;
+    std::size_t count;
+};
+
+} // namespace ga
@@ -0,0 +1,119 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "../genotype_view.hpp"
+#include "slab_allocator.hpp"
+
+#include <cstddef>
+#include <vector>
+#include <utility>
+
+
+namespace ga
+{
+
+enum class genome_layout
+{
+    genotype_major, // genes of one genotype are contiguous
+    gene_major      // values of one gene across all genotypes are contiguous (transposed)
+};
+
+
+// Genes of `genotypes_count` genotypes of the same length in one contiguous buffer.
+template <class T>
+class genome_matrix
+{
+public:
+    using value_type = T;
+    using view = genotype_view<T>;
+    using const_view = genotype_view<const T>;
+
+public:
+    genome_matrix(): genome_matrix(0, 0, genome_layout::genotype_major)
+    {
+    }
+
+    genome_matrix(const std::size_t genotypes_count,
+                  const std::size_t genome_length,
+                  const genome_layout layout = genome_layout::genotype_major):
+            genotypes_count(genotypes_count),
+            length(genome_length),
+            layout(layout),
+            genes(genotypes_count * genome_length)
+    {
+    }
+
+    std::size_t size() const
+    {
+        return genotypes_count;
+    }
+
+    std::size_t genome_length() const
+    {
+        return length;
+    }
+
+    genome_layout get_layout() const
+    {
+        return layout;
+    }
+
+    view genotype(const std::size_t index)
+    {
+        return layout == genome_layout::genotype_major ?
+               view(genes.data() + index * length, length) :
+               view(genes.data() + index, length, genotypes_count);
+    }
+
+    const_view genotype(const std::size_t index) const
+    {
+        return layout == genome_layout::genotype_major ?
+               const_view(genes.data() + index * length, length) :
+               const_view(genes.data() + index, length, genotypes_count);
+    }
+
+    // Values of the gene at `gene_index` across all genotypes.
+    view gene(const std::size_t gene_index)
+    {
+        return layout == genome_layout::genotype_major ?
+               view(genes.data() + gene_index, genotypes_count, length) :
+               view(genes.data() + gene_index * genotypes_count, genotypes_count);
+    }
+
+    const_view gene(const std::size_t gene_index) const
+    {
+        return layout == genome_layout::genotype_major ?
+               const_view(genes.data() + gene_index, genotypes_count, length) :
+               const_view(genes.data() + gene_index * genotypes_count, genotypes_count);
+    }
+
+    T *data()
+    {
+        return genes.data();
+    }
+
+    const T *data() const
+    {
+        return genes.data();
+    }
+
+    void swap(genome_matrix &other)
+    {
+        std::swap(genotypes_count, other.genotypes_count);
+        std::swap(length, other.length);
+        std::swap(layout, other.layout);
+        genes.swap(other.genes);
+    }
+
+private:
+    std::size_t genotypes_count;
+    std::size_t length;
+    genome_layout layout;
+    std::vector<T, slab_allocator<T>> genes; // aligned to 64 bytes
+};
+
+} // namespace ga
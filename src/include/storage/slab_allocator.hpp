@@ -0,0 +1,283 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+
+namespace ga
+{
+namespace detail
+{
+
+inline void *aligned_allocate(const std::size_t bytes, const std::size_t alignment)
+{
+    void *ptr = nullptr;
+#if defined(_MSC_VER)
+    ptr = _aligned_malloc(bytes > 0 ? bytes : 1, alignment);
+#else
+    if (posix_memalign(&ptr, alignment, bytes > 0 ? bytes : 1) != 0)
+    {
+        ptr = nullptr;
+    }
+#endif
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+
+inline void aligned_free(void *ptr)
+{
+#if defined(_MSC_VER)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace detail
+
+
+// Pool of equally sized slots carved from large chunks. Slots are aligned to 64 bytes, freed
+// slots are reused before new chunks are allocated, and chunks are only returned to the system
+// when the pool is destroyed. Requests larger than a slot are served by the heap.
+//
+// With huge pages, chunks are multiples of 2 MiB aligned to 2 MiB, and on Linux the kernel is
+// advised to back them with transparent huge pages.
+class slab_pool
+{
+public:
+    static const std::size_t alignment = 64;
+    static const std::size_t huge_page_size = 2 * 1024 * 1024;
+
+public:
+    slab_pool(const std::size_t slot_bytes, const std::size_t slots_per_chunk = 64, const bool use_huge_pages = false):
+            slot_size(round_up(std::max<std::size_t>(slot_bytes, sizeof(free_slot)), alignment)),
+            chunk_size(round_up(slot_size * std::max<std::size_t>(slots_per_chunk, 1), chunk_alignment(use_huge_pages))),
+            use_huge_pages(use_huge_pages),
+            free_slots(nullptr),
+            slots_in_use(0)
+    {
+    }
+
+    slab_pool(const slab_pool &) = delete;
+    slab_pool &operator=(const slab_pool &) = delete;
+
+    ~slab_pool()
+    {
+        for (const auto chunk : chunks)
+        {
+            detail::aligned_free(chunk);
+        }
+    }
+
+    void *allocate(const std::size_t bytes)
+    {
+        if (bytes > slot_size)
+        {
+            return detail::aligned_allocate(bytes, alignment);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (free_slots == nullptr)
+        {
+            add_chunk();
+        }
+
+        free_slot *slot = free_slots;
+        free_slots = slot->next;
+        ++slots_in_use;
+        return slot;
+    }
+
+    void deallocate(void *ptr, const std::size_t bytes)
+    {
+        if (bytes > slot_size)
+        {
+            detail::aligned_free(ptr);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        free_slots = new (ptr) free_slot{free_slots};
+        --slots_in_use;
+    }
+
+    std::size_t get_slot_size() const
+    {
+        return slot_size;
+    }
+
+    std::size_t get_chunk_size() const
+    {
+        return chunk_size;
+    }
+
+    std::size_t get_chunks_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return chunks.size();
+    }
+
+    std::size_t get_slots_in_use() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return slots_in_use;
+    }
+
+private:
+    struct free_slot
+    {
+        free_slot *next;
+    };
+
+    static std::size_t round_up(const std::size_t value, const std::size_t multiple)
+    {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+
+    static std::size_t chunk_alignment(const bool use_huge_pages)
+    {
+        if (use_huge_pages)
+        {
+            return huge_page_size;
+        }
+
+        return alignment;
+    }
+
+    void add_chunk()
+    {
+        chunks.reserve(chunks.size() + 1);
+        char *chunk = static_cast<char *>(detail::aligned_allocate(chunk_size, chunk_alignment(use_huge_pages)));
+        chunks.push_back(chunk);
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (use_huge_pages)
+        {
+            madvise(chunk, chunk_size, MADV_HUGEPAGE);
+        }
+#endif
+
+        // Slots are linked in address order.
+        for (std::size_t offset = chunk_size / slot_size * slot_size; offset > 0; offset -= slot_size)
+        {
+            free_slots = new (chunk + offset - slot_size) free_slot{free_slots};
+        }
+    }
+
+private:
+    const std::size_t slot_size;
+    const std::size_t chunk_size;
+    const bool use_huge_pages;
+    mutable std::mutex mutex;
+    std::vector<void *> chunks;
+    free_slot *free_slots;
+    std::size_t slots_in_use;
+};
+
+
+// Allocator of 64-byte aligned memory from a shared slab_pool. A default constructed allocator
+// has no pool and takes aligned memory from the heap. The allocator propagates with containers,
+// so memory always returns to the pool it came from.
+template <class T>
+class slab_allocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template <class U>
+    struct rebind
+    {
+        using other = slab_allocator<U>;
+    };
+
+public:
+    slab_allocator() noexcept
+    {
+    }
+
+    explicit slab_allocator(const std::shared_ptr<slab_pool> &pool) noexcept: pool(pool)
+    {
+    }
+
+    template <class U>
+    slab_allocator(const slab_allocator<U> &other) noexcept: pool(other.get_pool())
+    {
+    }
+
+    T *allocate(const std::size_t n)
+    {
+        const std::size_t bytes = n * sizeof(T);
+        return static_cast<T *>(pool ? pool->allocate(bytes) : detail::aligned_allocate(bytes, slab_pool::alignment));
+    }
+
+    void deallocate(T *ptr, const std::size_t n) noexcept
+    {
+        if (pool)
+        {
+            pool->deallocate(ptr, n * sizeof(T));
+        }
+        else
+        {
+            detail::aligned_free(ptr);
+        }
+    }
+
+    const std::shared_ptr<slab_pool> &get_pool() const
+    {
+        return pool;
+    }
+
+    template <class U>
+    bool operator==(const slab_allocator<U> &other) const
+    {
+        return pool == other.get_pool();
+    }
+
+    template <class U>
+    bool operator!=(const slab_allocator<U> &other) const
+    {
+        return pool != other.get_pool();
+    }
+
+private:
+    std::shared_ptr<slab_pool> pool;
+};
+
+
+// Allocator for genotypes of `genes_count` genes whose slots come from a new pool.
+template <class T>
+slab_allocator<T> make_slab_allocator(const std::size_t genes_count,
+                                      const std::size_t slots_per_chunk = 64,
+                                      const bool use_huge_pages = false)
+{
+    return slab_allocator<T>(std::make_shared<slab_pool>(genes_count * sizeof(T), slots_per_chunk, use_huge_pages));
+}
+
+} // namespace ga
@@ -0,0 +1,157 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "../genotype_constructor.hpp"
+#include "../functions.hpp"
+#include "../genotype_view.hpp"
+#include "../operators/change_set.hpp"
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+
+namespace ga
+{
+
+// Keeps every genotype of the generation as a separate object of the model representation.
+template <class GenotypeModel>
+class vector_storage
+{
+public:
+    using genotype = typename GenotypeModel::representation;
+    using gene_value_type = typename GenotypeModel::value_type;
+    using reference = genotype &;
+    using const_reference = const genotype &;
+    using fitness_function = functions::fitness<genotype>;
+
+public:
+    vector_storage(const std::shared_ptr<GenotypeModel> &model, const std::size_t max_size):
+            spare_child(model->create_genotype())
+    {
+        generation.reserve(max_size);
+        selected.reserve(max_size);
+        recycled.reserve(max_size);
+        is_selected.reserve(max_size);
+    }
+
+    std::size_t size() const
+    {
+        return generation.size();
+    }
+
+    reference operator[](const std::size_t index)
+    {
+        return generation[index];
+    }
+
+    const_reference operator[](const std::size_t index) const
+    {
+        return generation[index];
+    }
+
+    // Returns the genotype as the model representation. The buffer is used
+    // by storages which keep genes in some other form.
+    const genotype &as_representation(const std::size_t index, genotype & /*buffer*/) const
+    {
+        return generation[index];
+    }
+
+    void init(const genotype_constructor<GenotypeModel> &constructor, const std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            generation.push_back(constructor.construct_random(i));
+        }
+    }
+
+    // Leaves in the generation only genotypes with given indices in the given order. Genotypes
+    // which are not selected are kept to be overwritten by children.
+    void select(const std::vector<std::size_t> &indices)
+    {
+        is_selected.assign(generation.size(), false);
+        for (const auto index : indices)
+        {
+            selected.push_back(std::move(generation[index]));
+            is_selected[index] = true;
+        }
+
+        for (std::size_t i = 0; i < generation.size(); ++i)
+        {
+            if (!is_selected[i])
+            {
+                recycled.push_back(std::move(generation[i]));
+            }
+        }
+
+        generation.swap(selected);
+        selected.clear();
+    }
+
+    // Appends one or two children of the given parents. When change sets are given,
+    // they receive differences of the children from their parents. Children are written
+    // into recycled genotypes, so a generation of the same size does not allocate.
+    void add_children(GenotypeModel &model, const std::size_t first_parent, const std::size_t second_parent,
+                      const bool both,
+                      operators::change_set *first_changes = nullptr,
+                      operators::change_set *second_changes = nullptr)
+    {
+        genotype first = take_recycled(model);
+        genotype second = both ? take_recycled(model) : std::move(spare_child);
+
+        const genotype_view<const gene_value_type> a(generation[first_parent]);
+        const genotype_view<const gene_value_type> b(generation[second_parent]);
+        const genotype_view<gene_value_type> first_view(first);
+        const genotype_view<gene_value_type> second_view(second);
+
+        if (first_changes != nullptr)
+        {
+            model.crossover(a, b, first_view, second_view, *first_changes, *second_changes);
+            model.mutate(first_view, *first_changes);
+            if (both) model.mutate(second_view, *second_changes);
+        }
+        else
+        {
+            model.crossover(a, b, first_view, second_view);
+            model.mutate(first_view);
+            if (both) model.mutate(second_view);
+        }
+
+        generation.push_back(std::move(first));
+        if (both)
+        {
+            generation.push_back(std::move(second));
+        }
+        else
+        {
+            spare_child = std::move(second);
+        }
+    }
+
+private:
+    // Genotypes of the generation all have the length of the model.
+    genotype take_recycled(const GenotypeModel &model)
+    {
+        if (recycled.empty())
+        {
+            return model.create_genotype();
+        }
+
+        genotype result = std::move(recycled.back());
+        recycled.pop_back();
+        return result;
+    }
+
+private:
+    std::vector<genotype> generation;
+    std::vector<genotype> selected;
+    std::vector<genotype> recycled;
+    std::vector<bool> is_selected;
+    genotype spare_child;
+};
+
+} // namespace ga
@@ -0,0 +1,181 @@
+//          Copyright Andrey Lifanov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <memory>
+
+
+namespace ga
+{
+
+// Fixed set of worker threads which process chunks of an index range.
+// The calling thread takes part in the processing, so the pool of size N
+// starts only N - 1 additional threads.
+class thread_pool
+{
+public:
+    using chunk_function = std::function<void(std::size_t begin, std::size_t end, std::size_t chunk_index)>;
+
+public:
+    explicit thread_pool(const std::size_t threads_count):
+            threads_count(std::max<std::size_t>(threads_count, 1)),
+            stopped(false)
+    {
+        workers.reserve(this->threads_count - 1);
+        for (std::size_t i = 1; i < this->threads_count; ++i)
+        {
+            workers.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        job_started.notify_all();
+
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    std::size_t size() const
+    {
+        return threads_count;
+    }
+
+    static std::size_t chunks_for(const std::size_t count, const std::size_t chunk_size)
+    {
+        return chunk_size == 0 ? 0 : (count + chunk_size - 1) / chunk_size;
+    }
+
+    // Chunk size which gives every thread a few chunks to balance uneven workloads.
+    std::size_t default_chunk_size(const std::size_t count) const
+    {
+        return std::max<std::size_t>(1, count / (threads_count * 4));
+    }
+
+    // Calls `func` for every chunk of [0, count) and blocks until all of them are processed.
+    void parallel_for(const std::size_t count, const std::size_t size_of_chunk, chunk_function func)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        const std::size_t chunk_size = size_of_chunk == 0 ? default_chunk_size(count) : size_of_chunk;
+
+        if (workers.empty() || count <= chunk_size)
+        {
+            for (std::size_t i = 0; i * chunk_size < count; ++i)
+            {
+                func(i * chunk_size, std::min(count, (i + 1) * chunk_size), i);
+            }
+            return;
+        }
+
+        auto state = std::make_shared<job>(std::move(func), count, chunk_size);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current_job = state;
+        }
+        job_started.notify_all();
+
+        process_chunks(*state);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        job_finished.wait(lock, [&state] { return state->finished_chunks == state->chunks_count; });
+        current_job.reset();
+    }
+
+private:
+    struct job
+    {
+        job(chunk_function func, const std::size_t range_size, const std::size_t chunk_size):
+                func(std::move(func)),
+                range_size(range_size),
+                chunk_size(chunk_size),
+                chunks_count(chunks_for(range_size, chunk_size)),
+                next_chunk(0),
+                finished_chunks(0)
+        {
+        }
+
+        chunk_function func;
+        std::size_t range_size;
+        std::size_t chunk_size;
+        std::size_t chunks_count;
+        std::atomic<std::size_t> next_chunk;
+        std::size_t finished_chunks; // guarded by thread_pool::mutex
+    };
+
+    void process_chunks(job &state)
+    {
+        std::size_t processed = 0;
+        std::size_t i;
+        while ((i = state.next_chunk.fetch_add(1)) < state.chunks_count)
+        {
+            state.func(i * state.chunk_size, std::min(state.range_size, (i + 1) * state.chunk_size), i);
+            ++processed;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        state.finished_chunks += processed;
+        if (processed > 0 && state.finished_chunks == state.chunks_count)
+        {
+            job_finished.notify_one();
+        }
+    }
+
+    void worker_loop()
+    {
+        std::shared_ptr<job> last_job;
+
+        while (true)
+        {
+            std::shared_ptr<job> state;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                job_started.wait(lock, [this, &last_job] {
+                    return stopped || (current_job && current_job != last_job);
+                });
+                if (stopped)
+                {
+                    return;
+                }
+                state = current_job;
+            }
+
+            process_chunks(*state);
+            last_job = std::move(state);
+        }
+    }
+
+private:
+    std::size_t threads_count;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable job_started;
+    std::condition_variable job_finished;
+    std::shared_ptr<job> current_job;
+    bool stopped;
+};
+
+} // namespace ga
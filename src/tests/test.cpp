@@ -1,10 +1,31 @@
+// Allocations are counted to check that evolution in steady state does not allocate.
+#define GA_INSTRUMENTATION_COUNT_ALLOCATIONS
+
 #include "test.hpp"
 #include "../include/ga.hpp"
+#include "../include/api.hpp"
 #include "../include/detail/detail.hpp"
+#include "../include/static_algorithm.hpp"
+#include "../include/island_model.hpp"
+#include "../include/process_island_model.hpp"
+#include "../include/logging/async_logger.hpp"
+#include "../include/detail/spsc_queue.hpp"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <numeric>
+#include <cmath>
+#include <memory>
 #include <vector>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <cstdio>
+#include <csignal>
+#include <stdexcept>
+#include <string>
 
 
 namespace ga_test
@@ -43,6 +64,25 @@ void run()
     });
 
 
+    ga_detail_suite->add_case("one_point_crossover() into views", [](auto &assert) {
+        std::vector<int> parent_a(10);
+        std::iota(parent_a.begin(), parent_a.end(), 0);
+
+        std::vector<int> parent_b(10);
+        std::iota(parent_b.begin(), parent_b.end(), 10);
+
+        // Children are interleaved in one buffer, so both of them are views with stride 2.
+        std::vector<int> children(20);
+        ga::genotype_view<int> first(children.data(), 10, 2);
+        ga::genotype_view<int> second(children.data() + 1, 10, 2);
+
+        ga::detail::one_point_crossover(parent_a, parent_b, 5, first, second);
+
+        assert.equal_sequences("first child", first, std::vector<int>{0, 1, 2, 3, 4, 15, 16, 17, 18, 19});
+        assert.equal_sequences("second child", second, std::vector<int>{10, 11, 12, 13, 14, 5, 6, 7, 8, 9});
+    });
+
+
     ga_detail_suite->add_case("split_by_groups_and_select()", [](auto &assert) {
         {
             std::vector<int> values(18);
@@ -71,6 +111,1618 @@ void run()
         }
     });
 
+    ga_suite->add_case("thread_pool::parallel_for()", [](auto &assert) {
+        ga::thread_pool pool(4);
+        std::vector<int> values(1000, 0);
+
+        pool.parallel_for(values.size(), 7, [&values](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                values[i] = static_cast<int>(i);
+            }
+        });
+
+        std::vector<int> expected(1000);
+        std::iota(expected.begin(), expected.end(), 0);
+        assert.equal_sequences("every index is processed once", values, expected);
+    });
+
+
+    ga_suite->add_case("population::calculate_fitness() in parallel", [](auto &assert) {
+        auto model = std::make_shared<ga::genotype_model<int>>(ga::genotype_model<int>::gene_params{0, 100}, 20);
+        ga::functions::fitness<std::vector<int>> fitness = [](const std::vector<int> &g) {
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        };
+
+        ga::population<ga::genotype_model<int>> population(model, 301);
+        population.init();
+
+        population.calculate_fitness(fitness);
+        const double serial_best = population.get_best_achieved_fitness();
+        const double serial_overall = population.get_overall_fitness();
+
+        ga::thread_pool pool(3);
+        population.set_thread_pool(&pool, 16);
+        population.calculate_fitness(fitness);
+
+        assert("best fitness is the same", serial_best == population.get_best_achieved_fitness());
+        assert("overall fitness is the same", std::abs(serial_overall - population.get_overall_fitness()) < 1e-12);
+    });
+
+    ga_suite->add_case("fitness_cache with lru eviction", [](auto &assert) {
+        ga::fitness_cache<std::vector<int>> cache(2, ga::cache_eviction_policy::lru);
+        double fitness = 0;
+
+        cache.insert({1, 2}, 1.0);
+        cache.insert({3, 4}, 2.0);
+        assert("hit of cached genotype", cache.find({1, 2}, fitness) && fitness == 1.0);
+
+        cache.insert({5, 6}, 3.0);
+        assert("least recently used entry is evicted", !cache.find({3, 4}, fitness));
+        assert("recently used entry is kept", cache.find({1, 2}, fitness));
+        assert("new entry is kept", cache.find({5, 6}, fitness) && fitness == 3.0);
+        assert.equal("size is bounded", cache.size(), 2);
+        assert.equal("hits count", cache.get_hits_count(), 3);
+        assert.equal("misses count", cache.get_misses_count(), 1);
+    });
+
+
+    ga_suite->add_case("fitness_cache with clock eviction", [](auto &assert) {
+        ga::fitness_cache<std::vector<int>> cache(2, ga::cache_eviction_policy::clock);
+        double fitness = 0;
+
+        cache.insert({1, 2}, 1.0);
+        cache.insert({3, 4}, 2.0);
+        cache.find({1, 2}, fitness);
+
+        cache.insert({5, 6}, 3.0);
+        assert("referenced entry gets a second chance", cache.find({1, 2}, fitness));
+        assert("unreferenced entry is evicted", !cache.find({3, 4}, fitness));
+        assert.equal("size is bounded", cache.size(), 2);
+    });
+
+
+    ga_suite->add_case("population::calculate_fitness() with cache", [](auto &assert) {
+        auto model = std::make_shared<ga::genotype_model<int>>(ga::genotype_model<int>::gene_params{0, 100}, 20);
+        std::size_t calls = 0;
+        ga::functions::fitness<std::vector<int>> fitness = [&calls](const std::vector<int> &g) {
+            ++calls;
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        };
+
+        ga::population<ga::genotype_model<int>> population(model, 50);
+        population.init();
+        population.enable_fitness_cache(100, ga::cache_eviction_policy::lru);
+
+        population.calculate_fitness(fitness);
+        const double best = population.get_best_achieved_fitness();
+        const std::size_t first_calls = calls;
+        population.calculate_fitness(fitness);
+
+        assert.equal("unchanged generation is not re-evaluated", calls, first_calls);
+        assert("best fitness is the same", best == population.get_best_achieved_fitness());
+        assert.equal("cache hits", population.get_fitness_cache()->get_hits_count(), 50);
+    });
+
+    ga_suite->add_case("genome_matrix layouts", [](auto &assert) {
+        for (const auto layout : {ga::genome_layout::genotype_major, ga::genome_layout::gene_major})
+        {
+            ga::genome_matrix<int> matrix(3, 4, layout);
+            for (std::size_t i = 0; i < matrix.size(); ++i)
+            {
+                auto genotype = matrix.genotype(i);
+                std::iota(genotype.begin(), genotype.end(), static_cast<int>(i * 10));
+            }
+
+            assert.equal_sequences("second genotype", matrix.genotype(1), std::vector<int>{10, 11, 12, 13});
+            assert.equal_sequences("third gene", matrix.gene(2), std::vector<int>{2, 12, 22});
+        }
+
+        ga::genome_matrix<int> transposed(3, 4, ga::genome_layout::gene_major);
+        transposed.genotype(1)[2] = 7;
+        assert.equal("values of one gene are contiguous", transposed.data()[2 * 3 + 1], 7);
+    });
+
+
+    ga_suite->add_case("population with flat_storage", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+        auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 20);
+        model->set_crossover_operator(std::make_unique<ga::operators::one_point_crossover<model_type>>());
+        model->add_mutation_operator(
+                std::make_unique<ga::operators::random_value_shift_mutation<model_type>>(0.5));
+
+        ga::functions::view_fitness<int> fitness = [](ga::genotype_view<const int> g) {
+            return std::accumulate(g.begin(), g.end(), 0.0) / (100.0 * g.size());
+        };
+        ga::functions::rank_distribution rank = [](std::size_t) { return 0.5; };
+
+        ga::population<model_type, ga::flat_storage<model_type, ga::genome_layout::gene_major>> population(model, 51);
+        population.init();
+        population.enable_fitness_cache(64, ga::cache_eviction_policy::clock);
+
+        double first_best = 0;
+        for (std::size_t i = 0; i < 20; ++i)
+        {
+            population.evolve(fitness, rank, 5);
+            if (i == 0) first_best = population.get_best_achieved_fitness();
+        }
+
+        population.calculate_fitness(fitness);
+        const auto best = population.get_best_genotype();
+        assert.equal("population is refilled", population.size(), 51);
+        assert.equal("genotype length", best.size(), 20);
+        assert("fitness does not degrade", population.get_best_achieved_fitness() >= first_best);
+    });
+
+    ga_suite->add_case("population with double_buffered_storage does not allocate", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+        auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 30);
+        model->set_crossover_operator(std::make_unique<ga::operators::one_point_crossover<model_type>>());
+        model->add_mutation_operator(
+                std::make_unique<ga::operators::random_value_mutation<model_type, std::uniform_int_distribution<int>>>(0.5));
+        model->add_mutation_operator(
+                std::make_unique<ga::operators::random_value_shift_mutation<model_type>>(0.5));
+
+        ga::functions::fitness<std::vector<int>> fitness = [](const std::vector<int> &g) {
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        };
+        ga::functions::rank_distribution rank = [](std::size_t) { return 0.5; };
+
+        ga::population<model_type, ga::double_buffered_storage<model_type>> population(model, 101);
+        population.init();
+
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            population.evolve(fitness, rank, 5);
+        }
+
+        const auto allocations_before = ga::instrumentation::allocations_count();
+        for (std::size_t i = 0; i < 20; ++i)
+        {
+            population.evolve(fitness, rank, 5);
+        }
+
+        assert.equal("allocations in steady state", ga::instrumentation::allocations_count() - allocations_before, 0);
+        assert.equal("population is refilled", population.size(), 101);
+    });
+
+    ga_suite->add_case("fixed genotype model", [](auto &assert) {
+        using model_type = ga::fixed_genotype_model<int, 30>;
+        static_assert(model_type::size() == 30, "length is known at compile time");
+
+        auto model = ga::api::model::create_fixed_model<int, 30>(0, 100);
+        ga::api::model::set_one_point_crossover(model);
+        ga::api::model::add_random_value_mutation_with_uniform_distribution(model, 0.1);
+        ga::api::model::add_random_value_shift_mutation(model, 0.1);
+        model->seed(1);
+
+        ga::functions::fitness<std::array<int, 30>> fitness = [](const std::array<int, 30> &g) {
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        };
+        ga::functions::rank_distribution rank = [](std::size_t) { return 0.5; };
+
+        ga::population<model_type> population(model, 101);
+        population.seed(1);
+        population.init();
+        population.evolve(fitness, rank, 5);
+        const double first_best = population.get_best_achieved_fitness();
+
+        const auto allocations_before = ga::instrumentation::allocations_count();
+        for (std::size_t i = 0; i < 20; ++i)
+        {
+            population.evolve(fitness, rank, 5);
+        }
+        assert.equal("no allocations", ga::instrumentation::allocations_count() - allocations_before, 0);
+
+        population.calculate_fitness(fitness);
+        assert("fitness improves", population.get_best_achieved_fitness() > first_best);
+        assert.equal("population is refilled", population.size(), 101);
+
+        ga::functions::view_fitness<int> view_fitness = [](ga::genotype_view<const int> g) {
+            return std::accumulate(g.begin(), g.end(), 0.0) / (100.0 * g.size());
+        };
+        ga::population<model_type, ga::flat_storage<model_type>> flat_population(model, 51);
+        flat_population.init();
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            flat_population.evolve(view_fitness, rank, 5);
+        }
+        flat_population.calculate_fitness(view_fitness);
+        const auto best = flat_population.get_best_genotype();
+        assert("flat storage", std::all_of(best.cbegin(), best.cend(), [](int gene) { return gene >= 0 && gene <= 100; }));
+
+        ga::operators::uniform_crossover<model_type> uniform;
+        uniform.seed(1, 2);
+        std::array<int, 30> a{}, b{};
+        b.fill(1);
+        const auto children = uniform.apply(a, b);
+        bool is_complementary = true;
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            is_complementary = is_complementary && children.first[i] + children.second[i] == 1;
+        }
+        assert("array children", is_complementary);
+
+        ga::parameters params;
+        params.population_size = 50;
+        params.generations_limit = 20;
+        params.desired_fitness_cap = 2;
+        params.time_limit = std::chrono::seconds(60);
+        params.random_seed = 3;
+
+        ga::algorithm<model_type> algorithm(model, fitness, rank);
+        const auto result = algorithm.run(params);
+        const auto progress = algorithm.get_progress();
+        assert("algorithm runs", progress.has_best_genotype &&
+                                 fitness(progress.best_genotype) == progress.best_achieved_fitness &&
+                                 result.get_best_achieved_fitness() > 0.6);
+
+        auto static_run = ga::make_static_algorithm(
+                model, fitness,
+                ga::operators::one_point_crossover<model_type>(),
+                ga::operators::tournament_selection(0.5, 2),
+                ga::operators::random_value_shift_mutation<model_type>(0.5));
+        const auto static_best = static_run.run(params);
+        assert("static_algorithm runs", fitness(static_best) == static_run.get_statistics().get_best_achieved_fitness());
+    });
+
+
+    ga_suite->add_case("slab allocator", [](auto &assert) {
+        ga::slab_pool pool(120, 4);
+        assert.equal("slot size", pool.get_slot_size(), std::size_t{128});
+
+        void *first = pool.allocate(120);
+        void *second = pool.allocate(100);
+        assert("slots are aligned", reinterpret_cast<std::uintptr_t>(first) % 64 == 0 &&
+                                    reinterpret_cast<std::uintptr_t>(second) % 64 == 0);
+        pool.deallocate(first, 120);
+        assert("freed slot is reused", pool.allocate(120) == first);
+
+        void *large = pool.allocate(1000);
+        assert("large blocks are aligned", reinterpret_cast<std::uintptr_t>(large) % 64 == 0);
+        pool.deallocate(large, 1000);
+        assert.equal("slots in use", pool.get_slots_in_use(), std::size_t{2});
+        assert.equal("chunks", pool.get_chunks_count(), std::size_t{1});
+
+        ga::slab_pool huge_pool(4096, 16, true);
+        void *page = huge_pool.allocate(4096);
+        assert.equal("huge page chunks", huge_pool.get_chunk_size() % ga::slab_pool::huge_page_size, std::size_t{0});
+        huge_pool.deallocate(page, 4096);
+
+        using model_type = ga::genotype_model<int, ga::slab_allocator<int>>;
+        const auto allocator = ga::make_slab_allocator<int>(30, 32);
+        auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 30, allocator);
+        model->set_crossover_operator(std::make_unique<ga::operators::one_point_crossover<model_type>>());
+        model->add_mutation_operator(std::make_unique<ga::operators::random_value_shift_mutation<model_type>>(0.5));
+
+        ga::functions::fitness<model_type::representation> fitness = [](const model_type::representation &g) {
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        };
+        ga::functions::rank_distribution rank = [](std::size_t) { return 0.5; };
+
+        {
+            ga::population<model_type> population(model, 101);
+            population.init();
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                population.evolve(fitness, rank, 5);
+            }
+
+            const std::size_t chunks = allocator.get_pool()->get_chunks_count();
+            for (std::size_t i = 0; i < 10; ++i)
+            {
+                population.evolve(fitness, rank, 5);
+            }
+
+            assert.equal("no new chunks", allocator.get_pool()->get_chunks_count(), chunks);
+            assert("genotypes are in the pool", allocator.get_pool()->get_slots_in_use() >= 101);
+
+            population.calculate_fitness(fitness);
+            const auto best = population.get_best_genotype();
+            assert("genotypes are aligned", reinterpret_cast<std::uintptr_t>(best.data()) % 64 == 0);
+            assert("best genotype shares the pool", best.get_allocator() == allocator);
+        }
+
+        {
+            auto algorithm = ga::make_static_algorithm(
+                    model, fitness,
+                    ga::operators::one_point_crossover<model_type>(),
+                    ga::operators::tournament_selection(0.5, 2),
+                    ga::operators::random_value_shift_mutation<model_type>(0.5));
+
+            ga::parameters params;
+            params.population_size = 50;
+            params.generations_limit = 5;
+            params.desired_fitness_cap = 2;
+            params.time_limit = std::chrono::seconds(60);
+            const auto best = algorithm.run(params);
+            assert("static_algorithm genotypes are in the pool", allocator.get_pool()->get_slots_in_use() >= 100);
+            assert("static_algorithm best genotype shares the pool", best.get_allocator() == allocator);
+        }
+        assert.equal("slots are returned", allocator.get_pool()->get_slots_in_use(), std::size_t{0});
+    });
+
+
+    ga_suite->add_case("population with vector_storage recycles genotypes", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+        auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 30);
+        model->set_crossover_operator(std::make_unique<ga::operators::one_point_crossover<model_type>>());
+        model->add_mutation_operator(
+                std::make_unique<ga::operators::random_value_mutation<model_type, std::uniform_int_distribution<int>>>(0.5));
+        model->add_mutation_operator(
+                std::make_unique<ga::operators::random_value_shift_mutation<model_type>>(0.5));
+
+        ga::functions::fitness<std::vector<int>> fitness = [](const std::vector<int> &g) {
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        };
+        ga::functions::rank_distribution rank = [](std::size_t) { return 0.5; };
+
+        ga::population<model_type> population(model, 101);
+        population.init();
+
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            population.evolve(fitness, rank, 5);
+        }
+
+        const auto allocations_before = ga::instrumentation::allocations_count();
+        for (std::size_t i = 0; i < 20; ++i)
+        {
+            population.evolve(fitness, rank, 5);
+        }
+
+        assert.equal("allocations in steady state", ga::instrumentation::allocations_count() - allocations_before, 0);
+        assert.equal("population is refilled", population.size(), 101);
+    });
+
+    ga_suite->add_case("population::calculate_fitness() with batch function", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+        using population_type = ga::population<model_type>;
+        auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 20);
+
+        ga::functions::fitness<std::vector<int>> fitness = [](const std::vector<int> &g) {
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        };
+
+        std::atomic<std::size_t> evaluated{0};
+        population_type::batch_fitness_function batch_fitness =
+                [&fitness, &evaluated](const ga::genotype_batch<population_type::storage_type> &batch,
+                                       ga::functions::fitness_scores scores) {
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                scores[i] = fitness(batch[i]);
+            }
+            evaluated += batch.size();
+        };
+
+        population_type population(model, 101);
+        population.init();
+        population.calculate_fitness(fitness);
+        const double best = population.get_best_achieved_fitness();
+        const double overall = population.get_overall_fitness();
+
+        ga::thread_pool pool(3);
+        population.set_thread_pool(&pool, 10);
+        population.set_batch_fitness_function(batch_fitness);
+        population.calculate_fitness(fitness);
+
+        assert.equal("every genotype is evaluated by the batch function", evaluated.load(), 101);
+        assert("best fitness is the same", best == population.get_best_achieved_fitness());
+        assert("overall fitness is the same", std::abs(overall - population.get_overall_fitness()) < 1e-12);
+    });
+
+    ga_suite->add_case("population::calculate_fitness() with incremental fitness", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+        using population_type = ga::population<model_type, ga::double_buffered_storage<model_type>>;
+
+        struct sum_fitness : public population_type::incremental_fitness_type
+        {
+            double evaluate(const std::vector<int> &genotype, state_type &state) const override
+            {
+                ++full_evaluations;
+                state.assign(1, std::accumulate(genotype.cbegin(), genotype.cend(), 0.0));
+                return state[0] / (100.0 * genotype.size());
+            }
+
+            double update(const std::vector<int> &genotype, const std::vector<int> &parent, double,
+                          state_type &state, const ga::operators::change_set &changes) const override
+            {
+                for (const auto i : changes.get_indices())
+                {
+                    state[0] += genotype[i] - parent[i];
+                }
+                return state[0] / (100.0 * genotype.size());
+            }
+
+            mutable std::size_t full_evaluations = 0;
+        };
+
+        auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 50);
+        model->set_crossover_operator(std::make_unique<ga::operators::one_point_crossover<model_type>>());
+        model->add_mutation_operator(
+                std::make_unique<ga::operators::random_value_shift_mutation<model_type>>(0.5));
+
+        auto fitness = std::make_shared<sum_fitness>();
+        ga::functions::fitness<std::vector<int>> unused;
+        ga::functions::rank_distribution rank = [](std::size_t) { return 0.5; };
+
+        population_type population(model, 100);
+        population.init();
+        population.set_incremental_fitness(fitness);
+
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            population.evolve(unused, rank, 5);
+        }
+        population.calculate_fitness(unused);
+
+        double expected_sum = 0;
+        for (std::size_t i = 0; i < population.size(); ++i)
+        {
+            const auto &g = population.get_storage()[i];
+            expected_sum += std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        }
+
+        assert("overall fitness matches full evaluation",
+               std::abs(expected_sum / population.size() - population.get_overall_fitness()) < 1e-9);
+        assert("children are evaluated incrementally", fitness->full_evaluations < 200);
+    });
+
+    ga_operators_suite->add_case("selection engines", [](auto &assert) {
+        std::vector<std::unique_ptr<ga::operators::selection>> engines;
+        engines.push_back(std::make_unique<ga::operators::truncation_selection>(0.3));
+        engines.push_back(std::make_unique<ga::operators::tournament_selection>(0.3, 3));
+        engines.push_back(std::make_unique<ga::operators::stochastic_universal_sampling>(0.3));
+
+        for (auto &engine : engines)
+        {
+            std::vector<ga::genotype_fitness> candidates;
+            for (std::size_t i = 0; i < 100; ++i)
+            {
+                candidates.emplace_back(static_cast<double>((i * 37) % 100) / 100.0, i);
+            }
+
+            std::vector<ga::genotype_fitness> selected;
+            engine->select(candidates, selected);
+
+            std::vector<std::size_t> indices;
+            for (const auto &s : selected) indices.push_back(s.index);
+            std::sort(indices.begin(), indices.end());
+
+            assert("something is selected", selected.size() > 1);
+            assert("no more than requested is selected", selected.size() <= 30);
+            assert("best is the first", selected.front().fitness == 0.99);
+            assert("every genotype is selected once",
+                   std::adjacent_find(indices.begin(), indices.end()) == indices.end());
+        }
+
+        ga::operators::truncation_selection truncation(0.3);
+        std::vector<ga::genotype_fitness> candidates;
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            candidates.emplace_back(static_cast<double>(i), i);
+        }
+        std::vector<ga::genotype_fitness> selected;
+        truncation.select(candidates, selected);
+
+        std::vector<double> fitness;
+        for (const auto &s : selected) fitness.push_back(s.fitness);
+        std::sort(fitness.begin(), fitness.end());
+        assert.equal_sequences("truncation keeps the best", fitness, std::vector<double>{7, 8, 9});
+    });
+
+
+    ga_operators_suite->add_case("stochastic_universal_sampling with one fit genotype", [](auto &assert) {
+        ga::operators::stochastic_universal_sampling sus(0.3);
+        sus.seed(1, 4);
+        std::vector<ga::genotype_fitness> candidates;
+        for (std::size_t i = 0; i < 100; ++i)
+        {
+            candidates.emplace_back(i == 0 ? 1.0 : 0.0, i);
+        }
+
+        std::vector<ga::genotype_fitness> selected;
+        sus.select(candidates, selected);
+
+        std::vector<std::size_t> indices;
+        for (const auto &s : selected) indices.push_back(s.index);
+        std::sort(indices.begin(), indices.end());
+        assert.equal("requested count is selected", selected.size(), std::size_t{30});
+        assert("best is the first", selected.front().index == 0);
+        assert("every genotype is selected once",
+               std::adjacent_find(indices.begin(), indices.end()) == indices.end());
+
+        std::vector<ga::genotype_fitness> negative;
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            negative.emplace_back(-static_cast<double>((i * 7) % 10), i);
+        }
+        ga::operators::stochastic_universal_sampling(0.3).select(negative, selected);
+        std::vector<double> negative_fitness;
+        for (const auto &s : selected) negative_fitness.push_back(s.fitness);
+        assert.equal_sequences("negative fitness keeps the fittest", negative_fitness, std::vector<double>{0, -1, -2});
+
+        // Only one genotype scores above zero, like infeasible solutions of a knapsack problem.
+        using model_type = ga::genotype_model<int>;
+        auto model = ga::api::model::create_homogeneous_model<int>(0, 100, 10);
+        ga::api::model::set_one_point_crossover(model);
+        ga::api::model::add_random_value_shift_mutation(model, 0.1);
+        auto is_scored = std::make_shared<std::atomic<bool>>(false);
+        ga::functions::fitness<std::vector<int>> fitness = [is_scored](const std::vector<int> &) {
+            return is_scored->exchange(true) ? 0.0 : 1.0;
+        };
+        ga::functions::rank_distribution rank = [](std::size_t) { return 0.5; };
+
+        ga::population<model_type> population(model, 20);
+        population.set_selection(std::make_unique<ga::operators::stochastic_universal_sampling>(0.05));
+        population.seed(1);
+        population.init();
+        population.evolve(fitness, rank, 5);
+        assert.equal("population is refilled", population.size(), std::size_t{20});
+    });
+
+    ga_operators_suite->add_case("per_gene_random_value_shift_mutation", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+        using params_type = model_type::gene_params;
+
+        // Genes of the first half are never mutated.
+        const std::size_t size = 10000;
+        std::vector<params_type> params(size / 2, params_type(0, 100, 1, 1, 0.0));
+        params.resize(size, params_type(0, 100, 1, 1, 1.0));
+        const model_type model(params);
+
+        for (const double probability : {0.02, 0.5})
+        {
+            ga::operators::per_gene_random_value_shift_mutation<model_type> mutation(probability);
+            mutation.seed(42, 0);
+
+            std::size_t first_half_changes = 0;
+            std::size_t second_half_changes = 0;
+            bool changes_match = true;
+            for (int run = 0; run < 10; ++run)
+            {
+                std::vector<int> g(size, 50);
+                ga::operators::change_set changes;
+                mutation.apply(model, ga::genotype_view<int>(g), changes);
+
+                std::size_t changed = 0;
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    if (g[i] == 50) continue;
+                    ++changed;
+                    if (i < size / 2) ++first_half_changes; else ++second_half_changes;
+                }
+                changes_match = changes_match && changes.get_indices().size() == changed;
+            }
+
+            const double expected = probability * 10 * size / 2;
+            assert("genes with zero multiplier are kept", first_half_changes == 0);
+            assert("mutation rate is close to probability",
+                   second_half_changes > expected * 0.9 && second_half_changes < expected * 1.1);
+            assert("change set has every mutated gene", changes_match);
+        }
+
+        // A rate of 1 mutates every gene even below the dense rate.
+        ga::operators::per_gene_random_value_shift_mutation<model_type> certain(1.0, 2.0);
+        certain.seed(42, 0);
+        std::vector<int> g(size, 50);
+        certain.apply(model, g);
+        std::size_t first_half_changes = 0;
+        std::size_t second_half_changes = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (g[i] == 50) continue;
+            if (i < size / 2) ++first_half_changes; else ++second_half_changes;
+        }
+        assert("rate of 1 mutates every gene", first_half_changes == 0 && second_half_changes == size / 2);
+    });
+
+    ga_suite->add_case("philox_engine known answers", [](auto &assert) {
+        const auto zeros = ga::philox_engine::generate_block({{0, 0, 0, 0}}, {{0, 0}});
+        assert.equal_sequences("zero counter and key", zeros,
+                               std::vector<std::uint32_t>{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+
+        const auto ones = ga::philox_engine::generate_block({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+                                                            {{0xffffffff, 0xffffffff}});
+        assert.equal_sequences("all bits set", ones,
+                               std::vector<std::uint32_t>{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd});
+
+        ga::philox_engine engine(42, 7);
+        engine();
+        const auto state = engine.get_state();
+        const auto expected = engine();
+
+        ga::philox_engine restored;
+        restored.set_state(state);
+        assert.equal("restored engine continues the stream", restored(), expected);
+    });
+
+
+    ga_suite->add_case("seeded runs are reproducible", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+
+        const auto run = [](const std::size_t threads) {
+            auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 30);
+            model->set_crossover_operator(std::make_unique<ga::operators::one_point_crossover<model_type>>());
+            model->add_mutation_operator(
+                    std::make_unique<ga::operators::random_value_shift_mutation<model_type>>(0.5));
+
+            ga::algorithm<model_type> algorithm(model, [](const std::vector<int> &g) {
+                return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+            }, [](std::size_t) { return 0.5; });
+
+            ga::parameters params;
+            params.population_size = 100;
+            params.generations_limit = 30;
+            params.desired_fitness_cap = 2.0;
+            params.time_limit = std::chrono::seconds(60);
+            params.fitness_evaluation_threads = threads;
+            params.selection = ga::selection_method::tournament;
+            params.random_seed = 42;
+
+            auto population = algorithm.run(params);
+            return population.get_best_genotype();
+        };
+
+        assert.equal_sequences("same seed gives the same result regardless of threads", run(1), run(4));
+    });
+
+    ga_suite->add_case("static_algorithm", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+
+        const auto run = [] {
+            auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 30);
+            auto algorithm = ga::make_static_algorithm(
+                    model,
+                    [](const std::vector<int> &g) {
+                        return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+                    },
+                    ga::operators::one_point_crossover<model_type>(),
+                    ga::operators::tournament_selection(0.5, 2),
+                    ga::operators::random_value_shift_mutation<model_type>(0.5),
+                    ga::operators::random_value_mutation<model_type, std::uniform_int_distribution<int>>(0.5));
+
+            ga::parameters params;
+            params.population_size = 100;
+            params.generations_limit = 200;
+            params.desired_fitness_cap = 0.9;
+            params.time_limit = std::chrono::seconds(60);
+            params.random_seed = 42;
+
+            const auto best = algorithm.run(params);
+            return std::make_pair(best, algorithm.get_statistics().get_best_achieved_fitness());
+        };
+
+        const auto first = run();
+        assert("fitness cap is reached", first.second >= 0.9);
+        assert.equal_sequences("same seed gives the same result", first.first, run().first);
+    });
+
+    ga_detail_suite->add_case("spsc_queue", [](auto &assert) {
+        ga::detail::spsc_queue<std::vector<int>> queue(2);
+        std::vector<int> value{1};
+        assert("push into empty queue", queue.try_push(value));
+        value = {2};
+        assert("push into queue with free slot", queue.try_push(value));
+        value = {3};
+        assert("push into full queue fails", !queue.try_push(value));
+
+        std::vector<int> received;
+        assert("pop the first", queue.try_pop(received));
+        assert.equal_sequences("first in first out", received, std::vector<int>{1});
+
+        const std::size_t count = 10000;
+        std::thread producer([&queue, count] {
+            for (std::size_t i = 0; i < count; )
+            {
+                std::vector<int> item{static_cast<int>(i)};
+                if (queue.try_push(item)) ++i; else std::this_thread::yield();
+            }
+        });
+
+        assert("pop the second", queue.try_pop(received) && received.front() == 2);
+
+        bool is_ordered = true;
+        for (std::size_t i = 0; i < count; )
+        {
+            if (queue.try_pop(received))
+            {
+                is_ordered = is_ordered && received.front() == static_cast<int>(i);
+                ++i;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        assert("elements are received in order", is_ordered);
+    });
+
+
+    ga_suite->add_case("island_model", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+
+        const auto factory = [] {
+            auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 30);
+            model->set_crossover_operator(std::make_unique<ga::operators::one_point_crossover<model_type>>());
+            model->add_mutation_operator(
+                    std::make_unique<ga::operators::random_value_shift_mutation<model_type>>(0.5));
+            return model;
+        };
+
+        for (const auto topology : {ga::migration_topology::ring,
+                                    ga::migration_topology::fully_connected,
+                                    ga::migration_topology::random})
+        {
+            ga::island_model<model_type> islands(factory, [](const std::vector<int> &g) {
+                return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+            }, [](std::size_t) { return 0.5; });
+
+            ga::parameters params;
+            params.population_size = 50;
+            params.generations_limit = 100;
+            params.desired_fitness_cap = 2.0;
+            params.time_limit = std::chrono::seconds(60);
+            params.random_seed = 42;
+
+            ga::island_parameters island_params;
+            island_params.islands_count = 4;
+            island_params.topology = topology;
+            island_params.migration_interval = 5;
+
+            const auto populations = islands.run(params, island_params);
+            const auto &stats = islands.get_statistics();
+
+            double best = 0;
+            for (const auto &p : populations)
+            {
+                best = std::max(best, p.get_best_achieved_fitness());
+            }
+
+            assert.equal("every island is returned", populations.size(), std::size_t{4});
+            assert("islands evolve", best > 0.8);
+            assert("statistics has the best of islands", stats.get_best_achieved_fitness() == best);
+            assert("migrants are sent", stats.get_migrants_sent() + stats.get_migrants_dropped() > 0);
+        }
+    });
+
+    ga_detail_suite->add_case("process_channel", [](auto &assert) {
+        for (const auto transport : {ga::process_transport::shared_memory, ga::process_transport::local_socket})
+        {
+            ga::detail::process_channel channel(64, transport);
+            assert("transport is kept", channel.get_transport() == transport);
+
+            std::vector<unsigned char> received;
+            assert("nothing to receive", !channel.try_receive(received));
+
+            bool is_ordered = true;
+            for (unsigned char i = 0; i < 40; ++i)
+            {
+                const std::vector<unsigned char> message(static_cast<std::size_t>(i % 7 + 1), i);
+                assert("message is sent", channel.try_send(message));
+                is_ordered = is_ordered && channel.try_receive(received) && received == message;
+            }
+            assert("messages are received unchanged", is_ordered);
+
+            if (transport == ga::process_transport::shared_memory)
+            {
+                assert("message larger than the ring is rejected",
+                       !channel.try_send(std::vector<unsigned char>(64, 1)));
+            }
+        }
+    });
+
+
+    ga_detail_suite->add_case("genotypes serialization", [](auto &assert) {
+        const std::vector<std::vector<short>> genotypes{{1, 2, 3}, {-4, 5, 6}};
+        std::vector<unsigned char> buffer;
+        ga::detail::binary_writer writer(buffer);
+        ga::detail::write_genotypes(writer, genotypes);
+        assert.equal("genes are packed", buffer.size(), 2 * sizeof(std::uint32_t) + 6 * sizeof(short));
+
+        std::vector<std::vector<short>> decoded;
+        ga::detail::binary_reader reader(buffer.data(), buffer.size());
+        assert("genotypes are read", ga::detail::read_genotypes(reader, decoded));
+        assert("genotypes are restored", decoded == genotypes);
+
+        ga::detail::binary_reader truncated(buffer.data(), buffer.size() - 1);
+        assert("truncated data is rejected", !ga::detail::read_genotypes(truncated, decoded));
+    });
+
+
+    ga_suite->add_case("process_island_model", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+
+        const auto factory = [] {
+            auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 30);
+            model->set_crossover_operator(std::make_unique<ga::operators::one_point_crossover<model_type>>());
+            model->add_mutation_operator(
+                    std::make_unique<ga::operators::random_value_shift_mutation<model_type>>(0.5));
+            return model;
+        };
+        const auto fitness = [](const std::vector<int> &g) {
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        };
+
+        ga::parameters params;
+        params.population_size = 50;
+        params.generations_limit = 100;
+        params.desired_fitness_cap = 2.0;
+        params.time_limit = std::chrono::seconds(60);
+        params.random_seed = 42;
+
+        ga::island_parameters island_params;
+        island_params.islands_count = 3;
+        island_params.migration_interval = 5;
+
+        for (const auto transport : {ga::process_transport::shared_memory, ga::process_transport::local_socket})
+        {
+            ga::process_island_model<model_type> islands(factory, fitness, [](std::size_t) { return 0.5; });
+            islands.set_transport(transport);
+            islands.set_report_interval(std::chrono::milliseconds(1));
+
+            const auto best = islands.run(params, island_params);
+            const auto &stats = islands.get_statistics();
+
+            assert.equal("no worker fails", islands.get_failed_workers_count(), std::size_t{0});
+            assert("islands evolve", stats.get_best_achieved_fitness() > 0.8);
+            assert("best genotype is returned", fitness(best) == stats.get_best_achieved_fitness());
+            assert.equal("generations are counted", stats.get_last_generation_stats().generation_index, std::size_t{100});
+            assert("migrants are sent", stats.get_migrants_sent() > 0);
+        }
+
+        ga::process_island_model<model_type> crashing(factory, [](const std::vector<int> &) -> double {
+            std::abort();
+        }, [](std::size_t) { return 0.5; });
+        crashing.set_report_interval(std::chrono::milliseconds(1));
+        crashing.run(params, island_params);
+        assert.equal("crashed workers are counted", crashing.get_failed_workers_count(), std::size_t{3});
+
+        // Children are reaped by the system and their exit statuses are lost.
+        const auto previous_handler = std::signal(SIGCHLD, SIG_IGN);
+        params.generations_limit = 10;
+        ga::process_island_model<model_type> unwaited(factory, fitness, [](std::size_t) { return 0.5; });
+        unwaited.set_report_interval(std::chrono::milliseconds(1));
+        unwaited.run(params, island_params);
+        std::signal(SIGCHLD, previous_handler);
+        assert.equal("reaped workers are counted as failed", unwaited.get_failed_workers_count(), std::size_t{3});
+    });
+
+    ga_suite->add_case("checkpoint and resume", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+
+        auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 30);
+        model->set_crossover_operator(std::make_unique<ga::operators::one_point_crossover<model_type>>());
+        model->add_mutation_operator(
+                std::make_unique<ga::operators::random_value_shift_mutation<model_type>>(0.5));
+
+        ga::algorithm<model_type> algorithm(model, [](const std::vector<int> &g) {
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        }, [](std::size_t) { return 0.5; });
+
+        ga::parameters params;
+        params.population_size = 100;
+        params.generations_limit = 60;
+        params.desired_fitness_cap = 2.0;
+        params.time_limit = std::chrono::seconds(60);
+        params.selection = ga::selection_method::tournament;
+        params.random_seed = 42;
+
+        const auto uninterrupted = algorithm.run(params).get_best_genotype();
+
+        const std::string path = "ga_test_checkpoint.bin";
+        params.generations_limit = 30;
+        params.checkpoint_path = path;
+        params.checkpoint_interval = 7;
+        algorithm.run(params);
+
+        params.generations_limit = 60;
+        params.checkpoint_path.clear();
+        const auto resumed = algorithm.run(params, path);
+
+        assert.equal("generations are counted from the checkpoint",
+                     algorithm.get_statistics().get_last_generation_stats().generation_index, std::size_t{60});
+        assert.equal_sequences("resumed run continues the interrupted one", resumed.get_best_genotype(), uninterrupted);
+
+        bool is_rejected = false;
+        try
+        {
+            algorithm.run(params, path + ".missing");
+        }
+        catch (const std::runtime_error &)
+        {
+            is_rejected = true;
+        }
+        assert("missing checkpoint is rejected", is_rejected);
+
+        // Selection by ranking groups calls the rank function after fitness evaluation, so the
+        // run is cancelled in the middle of reproduction.
+        params.selection = ga::selection_method::ranking_groups;
+        params.checkpoint_path.clear();
+        const auto ranked = algorithm.run(params).get_best_genotype();
+
+        ga::cancellation_token token;
+        std::size_t evaluations = 0;
+        ga::algorithm<model_type> cancelled_algorithm(model, [&](const std::vector<int> &g) {
+            ++evaluations;
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        }, [&](std::size_t) {
+            if (evaluations >= 350) token.cancel();
+            return 0.5;
+        });
+
+        std::remove(path.c_str());
+        params.generations_limit = 30;
+        params.checkpoint_path = path;
+        params.checkpoint_interval = 1;
+        const auto cancelled = cancelled_algorithm.run(params, token);
+        assert("generation is interrupted", cancelled.is_interrupted());
+
+        params.generations_limit = 60;
+        params.checkpoint_path.clear();
+        const auto resumed_after_cancel = algorithm.run(params, path);
+        assert.equal_sequences("cancelled run keeps the last complete checkpoint",
+                               resumed_after_cancel.get_best_genotype(), ranked);
+
+        std::remove(path.c_str());
+    });
+
+    ga_suite->add_case("async_logger", [](auto &assert) {
+        struct recording_logger : public ga::logging::logger
+        {
+            explicit recording_logger(std::vector<std::size_t> &indices): indices(indices)
+            {
+            }
+
+            void operator()(const ga::statistics &stat) override
+            {
+                indices.push_back(stat.get_last_generation_stats().generation_index);
+            }
+
+            std::vector<std::size_t> &indices;
+        };
+
+        const auto log = [](const ga::logging::async_logger_options &options, std::vector<std::size_t> &indices) {
+            ga::logging::async_logger logger(std::make_unique<recording_logger>(indices), options);
+            ga::statistics stat;
+            for (std::size_t i = 1; i <= 100; ++i)
+            {
+                stat.add_generation_stats_entry(i, i <= 50 ? static_cast<double>(i) : 50.0);
+                logger(stat);
+            }
+            logger.flush();
+            return logger.get_dropped_count();
+        };
+
+        std::vector<std::size_t> all;
+        ga::logging::async_logger_options options;
+        assert.equal("nothing is dropped", log(options, all), std::size_t{0});
+        assert.equal("every generation is logged", all.size(), std::size_t{100});
+
+        std::vector<std::size_t> sampled;
+        options.every_nth = 10;
+        log(options, sampled);
+        assert.equal_sequences("every 10th generation is logged", sampled,
+                               std::vector<std::size_t>{10, 20, 30, 40, 50, 60, 70, 80, 90, 100});
+
+        std::vector<std::size_t> improvements;
+        options.every_nth = 1;
+        options.improvements_only = true;
+        log(options, improvements);
+        assert.equal("only improvements are logged", improvements.size(), std::size_t{50});
+
+        std::vector<std::size_t> limited;
+        options.improvements_only = false;
+        options.max_rate = 1;
+        log(options, limited);
+        assert.equal("rate is limited", limited.size(), std::size_t{1});
+
+        std::vector<std::size_t> overflowed;
+        options.max_rate = 0;
+        options.capacity = 4;
+        options.drain_interval = std::chrono::milliseconds(200);
+        const auto dropped = log(options, overflowed);
+        assert.equal("overflow is counted", dropped + overflowed.size(), std::size_t{100});
+        assert("overflow does not block", dropped > 0);
+    });
+
+    ga_suite->add_case("generations history", [](auto &assert) {
+        const auto indices = [](const ga::statistics &stat) {
+            std::vector<std::size_t> result;
+            for (const auto &record : stat.get_generations_stats())
+            {
+                result.push_back(record.generation_index);
+            }
+            return result;
+        };
+
+        ga::statistics unbounded;
+        unbounded.reserve_generation_stats_space(4);
+        ga::statistics ring;
+        ring.set_generations_history(4, ga::history_mode::ring);
+        ga::statistics downsampled;
+        downsampled.set_generations_history(4, ga::history_mode::downsampling);
+
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            unbounded.add_generation_stats_entry(i, 0);
+            ring.add_generation_stats_entry(i, 0);
+            downsampled.add_generation_stats_entry(i, 0);
+        }
+
+        assert.equal("all records are kept", unbounded.get_generations_stats().size(), std::size_t{10});
+        assert.equal_sequences("ring keeps the last records", indices(ring), std::vector<std::size_t>{6, 7, 8, 9});
+        assert.equal_sequences("downsampling keeps every 4th record", indices(downsampled),
+                               std::vector<std::size_t>{0, 4, 8});
+        assert.equal("sampling step", downsampled.get_sampling_step(), std::size_t{4});
+    });
+
+    ga_suite->add_case("fitness summary", [](auto &assert) {
+        ga::fitness_summary_accumulator accumulator;
+        for (int i = 1; i <= 3; ++i)
+        {
+            accumulator.add(i);
+        }
+        auto summary = accumulator.get();
+        assert.equal("small median is exact", summary.median, 2.0);
+        assert.equal("mean", summary.mean, 2.0);
+
+        ga::random_generator rg;
+        rg.seed(1, 1);
+        accumulator.reset();
+        for (int i = 0; i < 100000; ++i)
+        {
+            accumulator.add(rg.generate(std::uniform_real_distribution<double>(0.0, 1.0)));
+        }
+        summary = accumulator.get();
+        assert.equal("count", summary.count, std::size_t{100000});
+        assert("mean of uniform values", std::abs(summary.mean - 0.5) < 0.01);
+        assert("variance of uniform values", std::abs(summary.variance - 1.0 / 12) < 0.005);
+        assert("min and max", summary.min >= 0 && summary.min < 0.001 && summary.max < 1 && summary.max > 0.999);
+        assert("lower quartile", std::abs(summary.lower_quartile - 0.25) < 0.01);
+        assert("median", std::abs(summary.median - 0.5) < 0.01);
+        assert("upper quartile", std::abs(summary.upper_quartile - 0.75) < 0.01);
+
+        using model_type = ga::genotype_model<int>;
+        auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 30);
+        model->set_crossover_operator(std::make_unique<ga::operators::one_point_crossover<model_type>>());
+        model->add_mutation_operator(
+                std::make_unique<ga::operators::random_value_shift_mutation<model_type>>(0.5));
+
+        ga::algorithm<model_type> algorithm(model, [](const std::vector<int> &g) {
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        }, [](std::size_t) { return 0.5; });
+
+        ga::parameters params;
+        params.population_size = 50;
+        params.generations_limit = 20;
+        params.desired_fitness_cap = 2;
+        params.time_limit = std::chrono::seconds(60);
+        params.random_seed = 7;
+        params.gather_generations_statistics = true;
+        params.generations_history_limit = 8;
+        algorithm.run(params);
+
+        const auto history = algorithm.get_statistics().get_generations_stats();
+        assert.equal("history is bounded", history.size(), std::size_t{8});
+        const auto &last = history.back().summary;
+        assert.equal("summary covers the population", last.count, std::size_t{50});
+        assert.equal("summary max is the best fitness", last.max, history.back().best_achieved_fitness);
+        assert("summary is ordered", last.min <= last.lower_quartile && last.lower_quartile <= last.median &&
+                                     last.median <= last.upper_quartile && last.upper_quartile <= last.max);
+    });
+
+    ga_suite->add_case("phase instrumentation", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+        auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 30);
+        model->set_crossover_operator(std::make_unique<ga::operators::one_point_crossover<model_type>>());
+        model->add_mutation_operator(
+                std::make_unique<ga::operators::random_value_shift_mutation<model_type>>(0.5));
+
+        ga::algorithm<model_type> algorithm(model, [](const std::vector<int> &g) {
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        }, [](std::size_t) { return 0.5; });
+
+        ga::parameters params;
+        params.population_size = 50;
+        params.generations_limit = 10;
+        params.desired_fitness_cap = 2;
+        params.time_limit = std::chrono::seconds(60);
+        params.random_seed = 3;
+        algorithm.run(params);
+
+        const auto &stats = algorithm.get_statistics();
+        const auto &total = stats.get_total_phase_statistics();
+        const auto &last = stats.get_last_generation_stats().phases;
+        if (ga::instrumentation::is_enabled)
+        {
+            assert.equal("every genotype is evaluated", total.fitness_evaluations, std::uint64_t{500});
+            assert.equal("last generation", last.fitness_evaluations, std::uint64_t{50});
+            assert("phases are timed", total.fitness_nanoseconds > 0 && total.selection_nanoseconds > 0 &&
+                                       total.reproduction_nanoseconds > 0);
+            assert("crossovers are counted", total.crossovers > 0);
+            assert("mutations are counted", total.mutations > 0 && total.mutations <= 2 * total.crossovers);
+        }
+        else
+        {
+            assert.equal("nothing is measured", total.fitness_evaluations + total.crossovers + total.mutations +
+                                                total.fitness_nanoseconds, std::uint64_t{0});
+        }
+
+
+        ga::phase_statistics phases;
+        {
+            ga::instrumentation::generation_scope scope(phases);
+            std::vector<int> allocated(100);
+        }
+        assert.equal("allocated bytes", phases.bytes_allocated,
+                     std::uint64_t{ga::instrumentation::is_enabled ? 100 * sizeof(int) : 0});
+    });
+
+    ga_suite->add_case("cancellation", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+        auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 30);
+        model->set_crossover_operator(std::make_unique<ga::operators::one_point_crossover<model_type>>());
+        model->add_mutation_operator(
+                std::make_unique<ga::operators::random_value_shift_mutation<model_type>>(0.5));
+
+        ga::cancellation_token token;
+        std::size_t evaluations = 0;
+        ga::algorithm<model_type> algorithm(model, [&](const std::vector<int> &g) {
+            if (++evaluations == 130) token.cancel();
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        }, [](std::size_t) { return 0.5; });
+
+        ga::parameters params;
+        params.population_size = 50;
+        params.generations_limit = 100;
+        params.desired_fitness_cap = 2;
+        params.time_limit = std::chrono::seconds(60);
+        params.random_seed = 5;
+        params.gather_generations_statistics = true;
+
+        const auto population = algorithm.run(params, token);
+        assert("generation is interrupted", population.is_interrupted());
+        assert("evaluation stops inside the generation", evaluations < 150);
+        const auto &interrupted_summary = population.get_fitness_summary();
+        assert("unevaluated genotypes are not summarized",
+               population.get_overall_fitness() > 0 && population.get_overall_fitness() < 1 &&
+               interrupted_summary.count > 0 && interrupted_summary.count < 50 && interrupted_summary.min >= 0);
+        assert.equal("interrupted generation is not counted",
+                     algorithm.get_statistics().get_last_generation_stats().generation_index, std::size_t{2});
+
+        const auto progress = algorithm.get_progress();
+        assert("run is finished", progress.is_finished);
+        assert.equal("progress generations", progress.generations, std::size_t{2});
+        assert.equal("progress holds the best genotype", progress.best_genotype.size(), std::size_t{30});
+
+        ga::algorithm<model_type> slow_algorithm(model, [](const std::vector<int> &g) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return std::accumulate(g.cbegin(), g.cend(), 0.0) / (100.0 * g.size());
+        }, [](std::size_t) { return 0.5; });
+
+        ga::cancellation_token deadline;
+        const auto start = std::chrono::steady_clock::now();
+        deadline.set_deadline(start + std::chrono::milliseconds(300));
+        auto result = slow_algorithm.run_async(params, deadline);
+
+        while (slow_algorithm.get_progress().generations == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        const auto intermediate = slow_algorithm.get_progress();
+        assert("progress is readable while running", intermediate.has_best_genotype && !intermediate.best_genotype.empty());
+
+        result.get();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        assert("deadline is met", elapsed < std::chrono::milliseconds(600));
+        assert("best so far is kept", slow_algorithm.get_progress().best_achieved_fitness >=
+                                      intermediate.best_achieved_fitness);
+    });
+
+    ga_suite->add_case("steady state evolution", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+        auto model = std::make_shared<model_type>(model_type::gene_params{0, 100}, 30);
+        model->set_crossover_operator(std::make_unique<ga::operators::one_point_crossover<model_type>>());
+        model->add_mutation_operator(
+                std::make_unique<ga::operators::random_value_shift_mutation<model_type>>(0.5));
+
+        const auto fitness = [](const auto &g) {
+            return std::accumulate(g.begin(), g.end(), 0.0) / (100.0 * g.size());
+        };
+
+        ga::parameters params;
+        params.population_size = 60;
+        params.generations_limit = 40;
+        params.desired_fitness_cap = 2;
+        params.time_limit = std::chrono::seconds(60);
+        params.random_seed = 11;
+        params.gather_generations_statistics = true;
+        params.evolution = ga::evolution_mode::steady_state;
+
+        for (const auto replacement : {ga::steady_state_replacement::worst, ga::steady_state_replacement::tournament})
+        {
+            params.steady_state.replacement = replacement;
+            ga::algorithm<model_type> algorithm(model, fitness, [](std::size_t) { return 0.5; });
+            const auto population = algorithm.run(params);
+
+            const auto history = algorithm.get_statistics().get_generations_stats();
+            bool is_monotonic = true;
+            for (std::size_t i = 1; i < history.size(); ++i)
+            {
+                is_monotonic = is_monotonic && history[i].best_achieved_fitness >= history[i - 1].best_achieved_fitness;
+            }
+
+            assert("best fitness never decreases", is_monotonic);
+            assert("fitness improves", history.back().best_achieved_fitness > history.front().best_achieved_fitness);
+            assert.equal("best genotype has the best fitness", fitness(population.get_best_genotype()),
+                         population.get_best_achieved_fitness());
+            assert("mean follows the population", history.back().summary.mean > history.front().summary.mean);
+            assert.equal("population size is kept", population.size(), std::size_t{60});
+        }
+
+        ga::algorithm<model_type, ga::flat_storage<model_type>> flat_algorithm(
+                model, fitness, [](std::size_t) { return 0.5; });
+        const auto flat_population = flat_algorithm.run(params);
+        assert.equal("flat storage", fitness(flat_population.get_best_genotype()),
+                     flat_population.get_best_achieved_fitness());
+
+        // Checkpoints hold the fitness values of the individuals replaced in place.
+        ga::functions::fitness<std::vector<int>> vector_fitness = fitness;
+        ga::population<model_type> population(model, 60);
+        population.seed(11);
+        population.init();
+        population.evolve_steady_state(vector_fitness, 200, params.steady_state);
+
+        std::vector<unsigned char> buffer;
+        ga::detail::binary_writer writer(buffer);
+        population.save_state(writer);
+
+        ga::detail::binary_reader reader(buffer.data(), buffer.size());
+        std::uint64_t generation_size = 0, length = 0, selected_size = 0;
+        double best = 0, overall = 0;
+        reader.read(generation_size);
+        reader.read(length);
+        reader.read(selected_size);
+        reader.read(best);
+        reader.read(overall);
+        std::vector<std::vector<int>> genotypes(generation_size, std::vector<int>(length));
+        for (auto &g : genotypes)
+        {
+            ga::detail::read_genes<int>(reader, g, length);
+        }
+
+        bool is_current = selected_size == generation_size;
+        for (std::size_t i = 0; i < selected_size && is_current; ++i)
+        {
+            double saved = 0;
+            is_current = reader.read(saved) && saved == fitness(genotypes[i]);
+        }
+        assert("saved fitness values are current", is_current);
+        assert.equal("saved best fitness", best, population.get_best_achieved_fitness());
+
+        const std::string path = "ga_test_steady_state_checkpoint.bin";
+        params.generations_limit = 20;
+        params.checkpoint_path = path;
+        params.checkpoint_interval = 5;
+        ga::algorithm<model_type> checkpointed(model, fitness, [](std::size_t) { return 0.5; });
+        checkpointed.run(params);
+
+        params.generations_limit = 40;
+        params.checkpoint_path.clear();
+        const auto resumed = checkpointed.run(params, path);
+        assert.equal("steady state run is resumed",
+                     checkpointed.get_statistics().get_last_generation_stats().generation_index, std::size_t{40});
+        assert.equal("resumed best genotype has the best fitness", fitness(resumed.get_best_genotype()),
+                     resumed.get_best_achieved_fitness());
+        std::remove(path.c_str());
+    });
+
+    ga_operators_suite->add_case("binary genotypes", [](auto &assert) {
+        using model_type = ga::binary_genotype_model;
+        auto model = ga::api::model::create_binary_model(100);
+        assert.equal("words", model->size(), std::size_t{2});
+        assert.equal("bits", ga::binary::bits_count(*model), std::size_t{100});
+
+        ga::genotype_constructor<model_type> constructor(model);
+        constructor.seed(1);
+        auto a = constructor.construct_random(0);
+        auto b = constructor.construct_random(1);
+        assert("padding bits are clear", (a[1] >> 36) == 0 && (b[1] >> 36) == 0);
+
+        std::vector<std::uint64_t> bits(2, 0);
+        ga::binary::set(bits, 70, true);
+        assert("set and test", ga::binary::test(bits, 70) && !ga::binary::test(bits, 69));
+        assert.equal("count", ga::binary::count(bits), std::size_t{1});
+
+        ga::operators::binary_uniform_crossover<model_type> uniform;
+        ga::operators::binary_one_point_crossover<model_type> one_point;
+        uniform.seed(1, 2);
+        one_point.seed(1, 3);
+        bool keeps_bits = true;
+        for (int i = 0; i < 20; ++i)
+        {
+            for (const auto &children : {uniform.apply(a, b), one_point.apply(a, b)})
+            {
+                for (std::size_t w = 0; w < a.size(); ++w)
+                {
+                    // Every bit of a child comes from one parent and the other child gets the other one.
+                    keeps_bits = keeps_bits && (children.first[w] ^ children.second[w]) == (a[w] ^ b[w]) &&
+                                 ((children.first[w] & children.second[w]) == (a[w] & b[w]));
+                }
+            }
+        }
+        assert("crossovers exchange bits", keeps_bits);
+
+        auto long_model = ga::api::model::create_binary_model(64000);
+        for (const double probability : {0.01, 0.3})
+        {
+            ga::operators::bit_flip_mutation<model_type> mutation(probability);
+            mutation.seed(1, 4);
+            std::vector<std::uint64_t> genes(long_model->size(), 0);
+            mutation.apply(*long_model, genes);
+            const double expected = probability * 64000;
+            assert("bit flip rate", std::abs(ga::binary::count(genes) - expected) < 5 * std::sqrt(expected));
+        }
+
+        ga::operators::bit_flip_mutation<model_type> mutation(1.0);
+        std::vector<std::uint64_t> genes(2, 0);
+        mutation.apply(*model, genes);
+        assert.equal("padding bits are not flipped", ga::binary::count(genes), std::size_t{100});
+
+        ga::api::model::set_binary_uniform_crossover(long_model);
+        ga::api::model::add_bit_flip_mutation(long_model, 1.0 / 64000);
+        ga::algorithm<model_type> algorithm(long_model, [](const std::vector<std::uint64_t> &g) {
+            return static_cast<double>(ga::binary::count(g)) / 64000;
+        }, [](std::size_t) { return 0.5; });
+
+        ga::parameters params;
+        params.population_size = 40;
+        params.generations_limit = 30;
+        params.desired_fitness_cap = 2;
+        params.time_limit = std::chrono::seconds(60);
+        params.random_seed = 9;
+        params.gather_generations_statistics = true;
+        algorithm.run(params);
+        const auto history = algorithm.get_statistics().get_generations_stats();
+        assert("one max improves", history.back().best_achieved_fitness > history.front().best_achieved_fitness);
+    });
+
+
+    ga_detail_suite->add_case("crossover kernels", [](auto &assert) {
+        ga::random_generator rg(1, 2);
+        ga::random_generator copy(1, 2);
+        std::vector<std::uint32_t> bits;
+        ga::detail::random_bits(rg, bits, 100);
+        bool is_same_stream = bits.size() == 4;
+        for (const auto word : bits)
+        {
+            is_same_stream = is_same_stream && word == copy.get_engine()();
+        }
+        assert("bulk bits", is_same_stream);
+
+        // Lengths which are not multiples of the vector lanes leave scalar tails.
+        const auto check = [&](auto gene) {
+            using T = decltype(gene);
+            const std::size_t size = 75;
+            std::vector<T> a(size), b(size), first(size), second(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                a[i] = static_cast<T>(i);
+                b[i] = static_cast<T>(1000 + 3 * i);
+            }
+
+            ga::detail::uniform_crossover(a.data(), b.data(), first.data(), second.data(), size, bits.data());
+            bool is_uniform = true;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const bool from_a = ga::detail::test_bit(bits.data(), i);
+                is_uniform = is_uniform && first[i] == (from_a ? a[i] : b[i]) && second[i] == (from_a ? b[i] : a[i]);
+            }
+            assert("uniform", is_uniform);
+
+            ga::detail::blend_crossover(a.data(), b.data(), first.data(), second.data(), size, bits.data(), 0.3);
+            bool is_blend = true;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const bool is_blended = ga::detail::test_bit(bits.data(), i);
+                const auto is_integral = std::is_integral<T>();
+                const T expected_first = is_blended ? ga::detail::blend_gene(a[i], b[i], 0.3, is_integral) : a[i];
+                const T expected_second = is_blended ? ga::detail::blend_gene(b[i], a[i], 0.3, is_integral) : b[i];
+                is_blend = is_blend && first[i] == expected_first && second[i] == expected_second &&
+                           (!is_blended || std::abs(expected_first - (a[i] + 0.3 * (b[i] - a[i]))) <= 0.5);
+            }
+            assert("blend", is_blend);
+        };
+
+        check(short());
+        check(int());
+        check(double());
+    });
+
+
+    ga_operators_suite->add_case("uniform, two point and blend crossovers", [](auto &assert) {
+        using model_type = ga::genotype_model<int>;
+        const std::size_t size = 50;
+        std::vector<int> a(size), b(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            a[i] = static_cast<int>(i);
+            b[i] = static_cast<int>(-1 - 2 * i);
+        }
+
+        ga::operators::uniform_crossover<model_type> uniform;
+        ga::operators::two_point_crossover<model_type> two_point;
+        ga::operators::blend_crossover<model_type> blend;
+        std::vector<ga::operators::crossover<model_type> *> operators = {&uniform, &two_point, &blend};
+
+        for (auto *op : operators)
+        {
+            op->seed(1, 2);
+            const auto children = op->apply(a, b);
+
+            // Interleaved children are crossed by the strided path and must be the same.
+            op->seed(1, 2);
+            std::vector<int> interleaved(2 * size);
+            ga::genotype_view<int> first(interleaved.data(), size, 2);
+            ga::genotype_view<int> second(interleaved.data() + 1, size, 2);
+            op->apply(ga::genotype_view<const int>(a), ga::genotype_view<const int>(b), first, second);
+            assert.equal_sequences("strided first", first, children.first);
+            assert.equal_sequences("strided second", second, children.second);
+
+            bool is_between = true;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                is_between = is_between && children.first[i] <= a[i] && children.first[i] >= b[i] &&
+                             children.second[i] <= a[i] && children.second[i] >= b[i];
+            }
+            assert("genes are between the parents", is_between);
+
+            ga::operators::change_set first_changes, second_changes;
+            std::vector<int> first_child(size), second_child(size);
+            op->apply(ga::genotype_view<const int>(a), ga::genotype_view<const int>(b),
+                      ga::genotype_view<int>(first_child), ga::genotype_view<int>(second_child),
+                      first_changes, second_changes);
+
+            bool is_described = !first_changes.is_complete() && !second_changes.is_complete();
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const auto &first_parent = first_changes.get_reference_parent() == ga::operators::change_set::parent::first ? a : b;
+                const auto &second_parent = second_changes.get_reference_parent() == ga::operators::change_set::parent::first ? a : b;
+                const auto &first_indices = first_changes.get_indices();
+                const auto &second_indices = second_changes.get_indices();
+                const bool first_listed = std::find(first_indices.begin(), first_indices.end(), i) != first_indices.end();
+                const bool second_listed = std::find(second_indices.begin(), second_indices.end(), i) != second_indices.end();
+                is_described = is_described && (first_listed || first_child[i] == first_parent[i]) &&
+                               (second_listed || second_child[i] == second_parent[i]);
+            }
+            assert("change sets", is_described);
+        }
+
+        const auto uniform_children = uniform.apply(a, b);
+        std::size_t from_a = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            from_a += uniform_children.first[i] == a[i];
+        }
+        assert("uniform mixes parents", from_a > 10 && from_a < 40);
+
+        const auto two_point_children = two_point.apply(a, b);
+        std::size_t switches = 0;
+        for (std::size_t i = 1; i < size; ++i)
+        {
+            switches += (two_point_children.first[i] == a[i]) != (two_point_children.first[i - 1] == a[i - 1]);
+        }
+        assert.equal("two point switches", switches, std::size_t{2});
+
+        const std::vector<int> short_a = {1, 2}, short_b = {3, 4};
+        const auto short_children = two_point.apply(short_a, short_b);
+        assert.equal_sequences("two genes exchange the last one", short_children.first, std::vector<int>{1, 4});
+        const auto single_children = two_point.apply(std::vector<int>{1}, std::vector<int>{3});
+        assert.equal_sequences("one gene is copied", single_children.first, std::vector<int>{1});
+    });
+
+
+    ga_operators_suite->add_case("permutation genotypes", [](auto &assert) {
+        using model_type = ga::permutation_genotype_model;
+        using base_model_type = ga::permutation_base_model;
+        const std::size_t size = 10000;
+        auto model = ga::api::model::create_permutation_model(size);
+
+        ga::genotype_constructor<model_type> constructor(model);
+        constructor.seed(1);
+        const auto a = constructor.construct_random(0);
+        const auto b = constructor.construct_random(1);
+        assert("random permutations", ga::permutation::is_valid(a) && ga::permutation::is_valid(b) && a != b);
+
+        ga::operators::order_crossover<base_model_type> order;
+        ga::operators::partially_mapped_crossover<base_model_type> partially_mapped;
+        ga::operators::cycle_crossover<base_model_type> cycle;
+        std::vector<ga::operators::crossover<base_model_type> *> crossovers = {&order, &partially_mapped, &cycle};
+
+        for (auto *op : crossovers)
+        {
+            op->seed(1, 2);
+            const auto children = op->apply(a, b);
+            assert("children are permutations",
+                   ga::permutation::is_valid(children.first) && ga::permutation::is_valid(children.second));
+
+            op->seed(1, 2);
+            std::vector<std::uint32_t> interleaved(2 * size);
+            ga::genotype_view<std::uint32_t> first(interleaved.data(), size, 2);
+            ga::genotype_view<std::uint32_t> second(interleaved.data() + 1, size, 2);
+            op->apply(ga::genotype_view<const std::uint32_t>(a), ga::genotype_view<const std::uint32_t>(b), first, second);
+            assert.equal_sequences("views first", first, children.first);
+            assert.equal_sequences("views second", second, children.second);
+        }
+
+        const auto cycle_children = cycle.apply(a, b);
+        bool keeps_positions = true;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            keeps_positions = keeps_positions && (cycle_children.first[i] == a[i] || cycle_children.first[i] == b[i]) &&
+                              (cycle_children.first[i] == a[i]) == (cycle_children.second[i] == b[i]);
+        }
+        assert("cycle crossover keeps positions", keeps_positions);
+
+        ga::operators::swap_mutation<base_model_type> swap(1.0);
+        ga::operators::insert_mutation<base_model_type> insert(1.0);
+        ga::operators::inversion_mutation<base_model_type> inversion(1.0);
+        std::vector<ga::operators::mutation<base_model_type> *> mutations = {&swap, &insert, &inversion};
+
+        for (auto *op : mutations)
+        {
+            op->seed(1, 16);
+            auto genes = a;
+            for (int i = 0; i < 10; ++i)
+            {
+                op->apply(*model, genes);
+            }
+            assert("mutants are permutations", ga::permutation::is_valid(genes) && genes != a);
+
+            auto mutant = a;
+            ga::operators::change_set changes;
+            changes.reset(ga::operators::change_set::parent::first, size);
+            op->apply(*model, ga::genotype_view<std::uint32_t>(mutant), changes);
+            const auto &indices = changes.get_indices();
+            bool is_described = !changes.is_complete() && !indices.empty();
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                is_described = is_described &&
+                               (mutant[i] == a[i] || std::find(indices.begin(), indices.end(), i) != indices.end());
+            }
+            assert("change sets", is_described);
+        }
+
+        // Cities on a circle, the shortest route visits them in the order of angles.
+        const std::size_t cities = 30;
+        auto route_model = ga::api::model::create_permutation_model(cities);
+        ga::api::model::set_order_crossover(route_model);
+        ga::api::model::add_inversion_mutation(route_model, 0.5);
+        ga::api::model::add_swap_mutation(route_model, 0.5);
+        ga::algorithm<model_type> algorithm(route_model, [cities](const std::vector<std::uint32_t> &route) {
+            double length = 0;
+            for (std::size_t i = 0; i < cities; ++i)
+            {
+                const double angle = 2 * 3.14159265358979 * (static_cast<double>(route[(i + 1) % cities]) - route[i]) / cities;
+                length += 2 * std::abs(std::sin(angle / 2));
+            }
+            return 1.0 / length;
+        }, [](std::size_t) { return 0.5; });
+
+        ga::parameters params;
+        params.population_size = 60;
+        params.generations_limit = 50;
+        params.desired_fitness_cap = 2;
+        params.time_limit = std::chrono::seconds(60);
+        params.random_seed = 3;
+        params.gather_generations_statistics = true;
+        algorithm.run(params);
+        const auto history = algorithm.get_statistics().get_generations_stats();
+        assert("route shortens", history.back().best_achieved_fitness > history.front().best_achieved_fitness);
+    });
+
     ConsoleLogger logger;
     execute({ga_suite, ga_operators_suite, ga_detail_suite}, logger);
 }